@@ -0,0 +1,125 @@
+// Written by Aaron Barge
+// Copyright 2020
+
+#include "accumulator.hpp"
+
+namespace atn { // AaronTheNerd
+
+// ============================================================================
+// =============================== Definitions ================================
+// ============================================================================
+
+// ============================= Private Methods ==============================
+
+// Makes room for at least words partial sums.
+void accumulator::grow(const uint64_t& words) {
+    if (this->sums.size() >= words) return;
+    this->sums.resize(words, 0);
+    this->carries.resize(words, 0);
+}
+
+// Adds w to the partial sum at word i. An overflow is only counted, not
+// carried, so the count can fall behind by at most one per call and 2^64 - 1
+// calls at one word fit before a read.
+void accumulator::add_word(const uint64_t& i, const uint64_t& w) {
+    this->sums[i] += w;
+    this->carries[i] += this->sums[i] < w;
+}
+
+// ============================== Public Methods ==============================
+
+// =============================== Constructors ===============================
+
+accumulator::accumulator() {}
+
+accumulator::accumulator(const uInt_view& n) {
+    *this += n;
+}
+
+// ================================ Assignment ================================
+
+accumulator& accumulator::operator+=(const uInt_view& n) {
+    uint64_t words = (n.bit_length() + 63) >> 6;
+    this->grow(words);
+    for (uint64_t i = 0; i < words; ++i)
+        this->add_word(i, n.word(i));
+    return *this;
+}
+
+accumulator& accumulator::operator+=(const uint64_t& num) {
+    if (num == 0) return *this;
+    this->grow(1);
+    this->add_word(0, num);
+    return *this;
+}
+
+// Adds a * b one row per word of the shorter factor. Each row is a word
+// multiply and add along the longer factor whose carry stays in a register,
+// and only the carry out of the top of the row is left as an overflow count.
+accumulator& accumulator::add_product(const uInt_view& a, const uInt_view& b) {
+    uint64_t a_words = (a.bit_length() + 63) >> 6, b_words = (b.bit_length() + 63) >> 6;
+    if (a_words == 0 || b_words == 0) return *this;
+    const uInt_view& shorter = a_words <= b_words ? a : b;
+    const uInt_view& longer = a_words <= b_words ? b : a;
+    uint64_t rows = a_words <= b_words ? a_words : b_words;
+    uint64_t length = a_words <= b_words ? b_words : a_words;
+    this->factor.resize(length);
+    for (uint64_t j = 0; j < length; ++j)
+        this->factor[j] = longer.word(j);
+    this->grow(a_words + b_words);
+    for (uint64_t i = 0; i < rows; ++i) {
+        uint64_t digit = shorter.word(i);
+        if (digit == 0) continue;
+        uint64_t* row = this->sums.data() + i;
+        unsigned __int128 carry = 0;
+        for (uint64_t j = 0; j < length; ++j) {
+            carry += (unsigned __int128)digit * this->factor[j] + row[j];
+            row[j] = uint64_t(carry);
+            carry >>= 64;
+        }
+        this->add_word(i + length, uint64_t(carry));
+    }
+    return *this;
+}
+
+accumulator& accumulator::add_product(const uInt_view& a, const uint64_t& num) {
+    return this->add_product(a, uInt_view(&num, 1));
+}
+
+void accumulator::clear() {
+    this->sums.clear();
+    this->carries.clear();
+}
+
+// ================================== Value ===================================
+
+// Folds every overflow count into the word above it with one carry pass,
+// leaving an ordinary sum of words with no zero words on top.
+void accumulator::normalize() {
+    unsigned __int128 carry = 0;
+    for (uint64_t i = 0; i < this->sums.size(); ++i) {
+        carry += this->sums[i];
+        if (i != 0) carry += this->carries[i - 1];
+        this->sums[i] = uint64_t(carry);
+        carry >>= 64;
+    }
+    if (!this->sums.empty()) carry += this->carries.back();
+    for (; carry != 0; carry >>= 64)
+        this->sums.emplace_back(uint64_t(carry));
+    words_normalize(this->sums);
+    this->carries.assign(this->sums.size(), 0);
+}
+
+// The sum so far. Reading it normalizes the partial sums first.
+uInt accumulator::value() {
+    this->normalize();
+    return from_words(this->sums);
+}
+
+// The number of partial sum words held, an upper bound on the words in the
+// value.
+uint64_t accumulator::size() const {
+    return this->sums.size();
+}
+
+} // End namespace atn
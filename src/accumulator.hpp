@@ -0,0 +1,50 @@
+// Written by Aaron Barge
+// Copyright 2020
+
+// A running sum of many atn::uInt values and products which defers carry
+// propagation until the sum is read. Every word position holds a 64 bit
+// partial sum plus a count of the times that partial sum has overflowed, so
+// adding a value of k words is k word additions however long the sum already
+// is, and no carry ever ripples past the words being added. Products are
+// added row by row straight into the partial sums without building the
+// product first. Reading the value folds the overflow counts back in with a
+// single carry pass.
+
+#ifndef _UINTEGER_ACCUMULATOR_HPP_
+#define _UINTEGER_ACCUMULATOR_HPP_
+
+#include "uInt.hpp"
+
+namespace atn { // AaronTheNerd
+
+// ============================================================================
+// ============================== Predefinitions ==============================
+// ============================================================================
+
+class accumulator {
+  private:
+    // =========================== Private Methods ============================
+    void grow(const uint64_t&);
+    void add_word(const uint64_t&, const uint64_t&);
+    std::vector<uint64_t> sums;
+    std::vector<uint64_t> carries; // carries[i] is owed to sums[i + 1]
+    std::vector<uint64_t> factor;
+  public:
+    // ============================= Constructors =============================
+    accumulator();
+    explicit accumulator(const uInt_view&);
+    // ============================== Assignment ==============================
+    accumulator& operator+=(const uInt_view&);
+    accumulator& operator+=(const uint64_t&);
+    accumulator& add_product(const uInt_view&, const uInt_view&);
+    accumulator& add_product(const uInt_view&, const uint64_t&);
+    void clear();
+    // ================================ Value =================================
+    void normalize();
+    uInt value();
+    uint64_t size() const;
+};
+
+} // End namespace atn
+
+#endif // _UINTEGER_ACCUMULATOR_HPP_
@@ -0,0 +1,532 @@
+// Written by Aaron Barge
+// Copyright 2020
+
+// A fixed width counterpart to atn::uInt. The width is a template parameter
+// so the value lives inline in a std::array of 64 bit words instead of on the
+// heap, every loop has a trip count known at compile time and all of the
+// arithmetic is constexpr. Unlike atn::uInt all arithmetic wraps around
+// modulo 2^Bits, including subtraction.
+
+#ifndef _UINTEGER_FIXED_UINT_HPP_
+#define _UINTEGER_FIXED_UINT_HPP_
+
+#include "uInt.hpp"
+#include <array> // std::array
+#include <istream> // std::istream
+#include <ostream> // std::ostream
+
+namespace atn { // AaronTheNerd
+
+// ============================================================================
+// ============================== Predefinitions ==============================
+// ============================================================================
+
+template <uint64_t Bits>
+class fixed_uInt {
+    static_assert(Bits > 0, "fixed_uInt must have at least one bit");
+  public:
+    static constexpr uint64_t WORDS = (Bits + 63) / 64;
+    static constexpr uint64_t TOP_MASK = Bits % 64 == 0
+        ? negative_one : (uint64_t(1) << (Bits % 64)) - 1;
+  private:
+    // =========================== Private Methods ============================
+    constexpr void mask_top_word();
+    constexpr uint64_t bit_length() const;
+    constexpr uint64_t div_and_mod_word(const uint64_t&);
+    constexpr void div_and_mod(const fixed_uInt&, fixed_uInt&);
+  public:
+    std::array<uint64_t, WORDS> words;
+    // ============================= Constructors =============================
+    constexpr fixed_uInt();
+    constexpr fixed_uInt(const uint64_t&);
+    explicit fixed_uInt(const std::string&);
+    explicit fixed_uInt(const uInt&);
+    // ============================== To String ===============================
+    std::string to_string() const;
+    std::string to_string(const uint64_t&) const;
+    // ============================== Assignment ==============================
+    constexpr fixed_uInt& operator+=(const fixed_uInt&);
+    constexpr fixed_uInt& operator-=(const fixed_uInt&);
+    constexpr fixed_uInt& operator*=(const fixed_uInt&);
+    constexpr fixed_uInt& operator/=(const fixed_uInt&);
+    constexpr fixed_uInt& operator%=(const fixed_uInt&);
+    constexpr fixed_uInt& operator<<=(const uint64_t&);
+    constexpr fixed_uInt& operator>>=(const uint64_t&);
+    constexpr fixed_uInt& operator&=(const fixed_uInt&);
+    constexpr fixed_uInt& operator|=(const fixed_uInt&);
+    constexpr fixed_uInt& operator^=(const fixed_uInt&);
+    // ============================== Arithmetic ==============================
+    constexpr fixed_uInt operator+(const fixed_uInt&) const;
+    constexpr fixed_uInt operator-(const fixed_uInt&) const;
+    constexpr fixed_uInt operator*(const fixed_uInt&) const;
+    constexpr fixed_uInt operator/(const fixed_uInt&) const;
+    constexpr fixed_uInt operator%(const fixed_uInt&) const;
+    constexpr fixed_uInt operator<<(const uint64_t&) const;
+    constexpr fixed_uInt operator>>(const uint64_t&) const;
+    constexpr fixed_uInt operator&(const fixed_uInt&) const;
+    constexpr fixed_uInt operator|(const fixed_uInt&) const;
+    constexpr fixed_uInt operator^(const fixed_uInt&) const;
+    // ================================ Unary =================================
+    constexpr fixed_uInt& operator++();
+    constexpr fixed_uInt& operator--();
+    // ============================= Conditional ==============================
+    constexpr bool operator==(const fixed_uInt&) const;
+    constexpr bool operator!=(const fixed_uInt&) const;
+    constexpr bool operator<(const fixed_uInt&) const;
+    constexpr bool operator>(const fixed_uInt&) const;
+    constexpr bool operator<=(const fixed_uInt&) const;
+    constexpr bool operator>=(const fixed_uInt&) const;
+    // =============================== Casting ================================
+    constexpr explicit operator uint64_t() const;
+    explicit operator uInt() const;
+};
+
+// ============================================================================
+// =============================== Definitions ================================
+// ============================================================================
+
+// ============================= Private Methods ==============================
+
+template <uint64_t Bits>
+constexpr void fixed_uInt<Bits>::mask_top_word() {
+    this->words[WORDS - 1] &= TOP_MASK;
+}
+
+template <uint64_t Bits>
+constexpr uint64_t fixed_uInt<Bits>::bit_length() const {
+    for (uint64_t i = WORDS - 1; i != negative_one; --i) {
+        if (this->words[i] != 0)
+            return (i << 6) + 64 - __builtin_clzll(this->words[i]);
+    }
+    return 0;
+}
+
+// Divides by a single word in place, one 128 by 64 bit division per word,
+// and returns the remainder.
+template <uint64_t Bits>
+constexpr uint64_t fixed_uInt<Bits>::div_and_mod_word(const uint64_t& n) {
+    unsigned __int128 rem = 0;
+    for (uint64_t i = WORDS - 1; i != negative_one; --i) {
+        rem = (rem << 64) | this->words[i];
+        this->words[i] = uint64_t(rem / n);
+        rem %= n;
+    }
+    return uint64_t(rem);
+}
+
+// Performs a simultaneous division and modulo operation where the quotient
+// is stored in this and the remainder is stored in mod. Divisors which fit
+// in a single word take the word division path, otherwise Knuth's algorithm
+// D runs over the words as words_div_mod does: both operands are shifted so
+// the divisor's top bit is set, each quotient word is estimated from the top
+// two words of the remainder and corrected at most twice, and the remainder
+// is shifted back at the end.
+template <uint64_t Bits>
+constexpr void fixed_uInt<Bits>::div_and_mod(const fixed_uInt& n, fixed_uInt& mod) {
+    uint64_t n_length = n.bit_length();
+    if (n_length == 0) {
+        throw std::runtime_error("ERROR: Divide/Mod by 0 Exception");
+    }
+    mod = fixed_uInt();
+    if (n_length <= 64) {
+        mod.words[0] = this->div_and_mod_word(n.words[0]);
+        return;
+    }
+    if (*this < n) {
+        mod = *this;
+        *this = fixed_uInt();
+        return;
+    }
+    uint64_t v_words = (n_length + 63) >> 6, u_words = (this->bit_length() + 63) >> 6;
+    uint64_t s = __builtin_clzll(n.words[v_words - 1]);
+    std::array<uint64_t, WORDS> vn{};
+    std::array<uint64_t, WORDS + 1> un{};
+    for (uint64_t i = v_words - 1; i != 0; --i)
+        vn[i] = (n.words[i] << s) | (s != 0 ? n.words[i - 1] >> (64 - s) : 0);
+    vn[0] = n.words[0] << s;
+    un[u_words] = s != 0 ? this->words[u_words - 1] >> (64 - s) : 0;
+    for (uint64_t i = u_words - 1; i != 0; --i)
+        un[i] = (this->words[i] << s) | (s != 0 ? this->words[i - 1] >> (64 - s) : 0);
+    un[0] = this->words[0] << s;
+    fixed_uInt quotient;
+    for (uint64_t j = u_words - v_words; j != negative_one; --j) {
+        unsigned __int128 numerator = ((unsigned __int128)un[j + v_words] << 64) | un[j + v_words - 1];
+        unsigned __int128 qhat = numerator / vn[v_words - 1];
+        unsigned __int128 rhat = numerator % vn[v_words - 1];
+        while ((qhat >> 64) != 0
+                || qhat * vn[v_words - 2] > ((rhat << 64) | un[j + v_words - 2])) {
+            --qhat;
+            rhat += vn[v_words - 1];
+            if ((rhat >> 64) != 0) break;
+        }
+        unsigned __int128 carry = 0;
+        uint64_t borrow = 0;
+        for (uint64_t i = 0; i < v_words; ++i) {
+            carry += qhat * vn[i];
+            uint64_t product = uint64_t(carry);
+            carry >>= 64;
+            uint64_t difference = un[i + j] - product - borrow;
+            borrow = un[i + j] < product || (un[i + j] == product && borrow);
+            un[i + j] = difference;
+        }
+        uint64_t top = uint64_t(carry);
+        uint64_t difference = un[j + v_words] - top - borrow;
+        borrow = un[j + v_words] < top || (un[j + v_words] == top && borrow);
+        un[j + v_words] = difference;
+        quotient.words[j] = uint64_t(qhat);
+        if (borrow) {
+            --quotient.words[j];
+            carry = 0;
+            for (uint64_t i = 0; i < v_words; ++i) {
+                carry += (unsigned __int128)un[i + j] + vn[i];
+                un[i + j] = uint64_t(carry);
+                carry >>= 64;
+            }
+            un[j + v_words] += uint64_t(carry);
+        }
+    }
+    for (uint64_t i = 0; i < v_words; ++i)
+        mod.words[i] = (un[i] >> s) | (s != 0 ? un[i + 1] << (64 - s) : 0);
+    *this = quotient;
+}
+
+// ============================== Public Methods ==============================
+
+// =============================== Constructors ===============================
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>::fixed_uInt() : words() {}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>::fixed_uInt(const uint64_t& num) : words() {
+    this->words[0] = num;
+    this->mask_top_word();
+}
+
+template <uint64_t Bits>
+fixed_uInt<Bits>::fixed_uInt(const std::string& str)
+        : fixed_uInt(uInt(str)) {}
+
+// Keeps the lowest Bits bits of n.
+template <uint64_t Bits>
+fixed_uInt<Bits>::fixed_uInt(const uInt& n) : words() {
+    std::vector<uint64_t> limbs = to_words(n);
+    uint64_t end = limbs.size() < WORDS ? limbs.size() : WORDS;
+    for (uint64_t i = 0; i < end; ++i)
+        this->words[i] = limbs[i];
+    this->mask_top_word();
+}
+
+// ================================ To String =================================
+
+template <uint64_t Bits>
+std::string fixed_uInt<Bits>::to_string() const {
+    return uInt(*this).to_string();
+}
+
+template <uint64_t Bits>
+std::string fixed_uInt<Bits>::to_string(const uint64_t& base) const {
+    return uInt(*this).to_string(base);
+}
+
+// ================================ Assignment ================================
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>& fixed_uInt<Bits>::operator+=(const fixed_uInt& n) {
+    bool carry = false;
+    for (uint64_t i = 0; i < WORDS; ++i) {
+        uint64_t sum = this->words[i] + n.words[i];
+        bool next = sum < this->words[i];
+        this->words[i] = sum + carry;
+        carry = next || this->words[i] < sum;
+    }
+    this->mask_top_word();
+    return *this;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>& fixed_uInt<Bits>::operator-=(const fixed_uInt& n) {
+    bool borrow = false;
+    for (uint64_t i = 0; i < WORDS; ++i) {
+        uint64_t difference = this->words[i] - n.words[i];
+        bool next = difference > this->words[i];
+        this->words[i] = difference - borrow;
+        borrow = next || this->words[i] > difference;
+    }
+    this->mask_top_word();
+    return *this;
+}
+
+// Schoolbook multiplication which skips every partial product that would
+// land above the top word.
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>& fixed_uInt<Bits>::operator*=(const fixed_uInt& n) {
+    fixed_uInt product;
+    for (uint64_t i = 0; i < WORDS; ++i) {
+        if (this->words[i] == 0) continue;
+        unsigned __int128 carry = 0;
+        for (uint64_t j = 0; i + j < WORDS; ++j) {
+            carry += (unsigned __int128)this->words[i] * n.words[j] + product.words[i + j];
+            product.words[i + j] = uint64_t(carry);
+            carry >>= 64;
+        }
+    }
+    *this = product;
+    this->mask_top_word();
+    return *this;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>& fixed_uInt<Bits>::operator/=(const fixed_uInt& n) {
+    fixed_uInt mod;
+    this->div_and_mod(n, mod);
+    return *this;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>& fixed_uInt<Bits>::operator%=(const fixed_uInt& n) {
+    fixed_uInt mod;
+    this->div_and_mod(n, mod);
+    *this = mod;
+    return *this;
+}
+
+// Moves whole words first and then funnel shifts the remaining bits.
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>& fixed_uInt<Bits>::operator<<=(const uint64_t& pos) {
+    if (pos >= Bits) return *this = fixed_uInt();
+    uint64_t word_shift = pos >> 6, bit_shift = pos & 63;
+    for (uint64_t i = WORDS - 1; i != negative_one; --i) {
+        uint64_t high = i >= word_shift ? this->words[i - word_shift] : 0;
+        uint64_t low = i >= word_shift + 1 ? this->words[i - word_shift - 1] : 0;
+        this->words[i] = bit_shift == 0
+            ? high : (high << bit_shift) | (low >> (64 - bit_shift));
+    }
+    this->mask_top_word();
+    return *this;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>& fixed_uInt<Bits>::operator>>=(const uint64_t& pos) {
+    if (pos >= Bits) return *this = fixed_uInt();
+    uint64_t word_shift = pos >> 6, bit_shift = pos & 63;
+    for (uint64_t i = 0; i < WORDS; ++i) {
+        uint64_t low = i + word_shift < WORDS ? this->words[i + word_shift] : 0;
+        uint64_t high = i + word_shift + 1 < WORDS ? this->words[i + word_shift + 1] : 0;
+        this->words[i] = bit_shift == 0
+            ? low : (low >> bit_shift) | (high << (64 - bit_shift));
+    }
+    return *this;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>& fixed_uInt<Bits>::operator&=(const fixed_uInt& n) {
+    for (uint64_t i = 0; i < WORDS; ++i)
+        this->words[i] &= n.words[i];
+    return *this;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>& fixed_uInt<Bits>::operator|=(const fixed_uInt& n) {
+    for (uint64_t i = 0; i < WORDS; ++i)
+        this->words[i] |= n.words[i];
+    return *this;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>& fixed_uInt<Bits>::operator^=(const fixed_uInt& n) {
+    for (uint64_t i = 0; i < WORDS; ++i)
+        this->words[i] ^= n.words[i];
+    return *this;
+}
+
+// ================================ Arithmetic ================================
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> fixed_uInt<Bits>::operator+(const fixed_uInt& n) const {
+    fixed_uInt sum(*this);
+    return sum += n;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> fixed_uInt<Bits>::operator-(const fixed_uInt& n) const {
+    fixed_uInt difference(*this);
+    return difference -= n;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> fixed_uInt<Bits>::operator*(const fixed_uInt& n) const {
+    fixed_uInt product(*this);
+    return product *= n;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> fixed_uInt<Bits>::operator/(const fixed_uInt& n) const {
+    fixed_uInt quotient(*this);
+    return quotient /= n;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> fixed_uInt<Bits>::operator%(const fixed_uInt& n) const {
+    fixed_uInt mod(*this);
+    return mod %= n;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> fixed_uInt<Bits>::operator<<(const uint64_t& pos) const {
+    fixed_uInt lsh(*this);
+    return lsh <<= pos;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> fixed_uInt<Bits>::operator>>(const uint64_t& pos) const {
+    fixed_uInt rsh(*this);
+    return rsh >>= pos;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> fixed_uInt<Bits>::operator&(const fixed_uInt& n) const {
+    fixed_uInt and_result(*this);
+    return and_result &= n;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> fixed_uInt<Bits>::operator|(const fixed_uInt& n) const {
+    fixed_uInt or_result(*this);
+    return or_result |= n;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> fixed_uInt<Bits>::operator^(const fixed_uInt& n) const {
+    fixed_uInt xor_result(*this);
+    return xor_result ^= n;
+}
+
+// ================================ Unary =================================
+
+// Stops at the first word which does not overflow.
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>& fixed_uInt<Bits>::operator++() {
+    for (uint64_t i = 0; i < WORDS && ++this->words[i] == 0; ++i) {}
+    this->mask_top_word();
+    return *this;
+}
+
+// Stops at the first word which does not underflow.
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>& fixed_uInt<Bits>::operator--() {
+    for (uint64_t i = 0; i < WORDS && this->words[i]-- == 0; ++i) {}
+    this->mask_top_word();
+    return *this;
+}
+
+// ============================= Conditional ==============================
+
+template <uint64_t Bits>
+constexpr bool fixed_uInt<Bits>::operator==(const fixed_uInt& n) const {
+    for (uint64_t i = 0; i < WORDS; ++i) {
+        if (this->words[i] != n.words[i]) return false;
+    }
+    return true;
+}
+
+template <uint64_t Bits>
+constexpr bool fixed_uInt<Bits>::operator!=(const fixed_uInt& n) const {
+    return !(*this == n);
+}
+
+template <uint64_t Bits>
+constexpr bool fixed_uInt<Bits>::operator<(const fixed_uInt& n) const {
+    for (uint64_t i = WORDS - 1; i != negative_one; --i) {
+        if (this->words[i] != n.words[i]) return this->words[i] < n.words[i];
+    }
+    return false;
+}
+
+template <uint64_t Bits>
+constexpr bool fixed_uInt<Bits>::operator>(const fixed_uInt& n) const {
+    return n < *this;
+}
+
+template <uint64_t Bits>
+constexpr bool fixed_uInt<Bits>::operator<=(const fixed_uInt& n) const {
+    return !(n < *this);
+}
+
+template <uint64_t Bits>
+constexpr bool fixed_uInt<Bits>::operator>=(const fixed_uInt& n) const {
+    return !(*this < n);
+}
+
+// =============================== Casting ================================
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits>::operator uint64_t() const {
+    return this->words[0];
+}
+
+template <uint64_t Bits>
+fixed_uInt<Bits>::operator uInt() const {
+    return from_words(std::vector<uint64_t>(this->words.begin(), this->words.end()));
+}
+
+// =========================== Non-Class Functions ============================
+
+template <uint64_t Bits>
+std::ostream& operator<<(std::ostream& out, const fixed_uInt<Bits>& n) {
+    out << n.to_string();
+    return out;
+}
+
+// Reads n the way operator>> reads a uInt, keeping the lowest Bits bits.
+template <uint64_t Bits>
+std::istream& operator>>(std::istream& in, fixed_uInt<Bits>& n) {
+    uInt value(n);
+    in >> value;
+    n = fixed_uInt<Bits>(value);
+    return in;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> operator+(const uint64_t& num, const fixed_uInt<Bits>& n) {
+    return n + num;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> operator-(const uint64_t& num, const fixed_uInt<Bits>& n) {
+    return fixed_uInt<Bits>(num) - n;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> operator*(const uint64_t& num, const fixed_uInt<Bits>& n) {
+    return n * num;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> operator/(const uint64_t& num, const fixed_uInt<Bits>& n) {
+    return fixed_uInt<Bits>(num) / n;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> operator%(const uint64_t& num, const fixed_uInt<Bits>& n) {
+    return fixed_uInt<Bits>(num) % n;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> operator&(const uint64_t& num, const fixed_uInt<Bits>& n) {
+    return n & num;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> operator|(const uint64_t& num, const fixed_uInt<Bits>& n) {
+    return n | num;
+}
+
+template <uint64_t Bits>
+constexpr fixed_uInt<Bits> operator^(const uint64_t& num, const fixed_uInt<Bits>& n) {
+    return n ^ num;
+}
+
+} // End namespace atn
+
+#endif // _UINTEGER_FIXED_UINT_HPP_
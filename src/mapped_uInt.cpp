@@ -0,0 +1,197 @@
+// Written by Aaron Barge
+// Copyright 2020
+
+#include "mapped_uInt.hpp"
+#include <algorithm> // std::copy
+#include <cerrno> // errno
+#include <cstdlib> // mkstemp
+#include <cstring> // std::strerror
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap, munmap, madvise, msync
+#include <sys/stat.h> // fstat
+#include <unistd.h> // close, ftruncate, unlink
+
+// Words per block, one 4KiB page of a 64 bit operand.
+#define MAPPED_BLOCK_WORDS 512
+
+namespace atn { // AaronTheNerd
+
+// ============================================================================
+// =============================== Definitions ================================
+// ============================================================================
+
+// ============================= Private Methods ==============================
+
+void mapped_uInt::check(const bool& ok, const std::string& action) const {
+    if (!ok) {
+        throw std::runtime_error("ERROR: Cannot " + action + " " + this->path
+            + ": " + std::strerror(errno));
+    }
+}
+
+// Changes the number of words in the file and maps the new size. Growing the
+// file fills the new words with zeros.
+void mapped_uInt::resize(const uint64_t& words) {
+    if (words == this->length && (words == 0 || this->limbs != nullptr)) return;
+    if (this->limbs != nullptr) {
+        munmap(this->limbs, this->length * sizeof(uint64_t));
+        this->limbs = nullptr;
+    }
+    this->check(ftruncate(this->fd, words * sizeof(uint64_t)) == 0, "resize");
+    this->length = words;
+    if (words == 0) return;
+    void* mapping = mmap(nullptr, words * sizeof(uint64_t),
+        PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+    this->check(mapping != MAP_FAILED, "map");
+    this->limbs = static_cast<uint64_t*>(mapping);
+}
+
+void mapped_uInt::normalize() {
+    uint64_t words = this->length;
+    while (words != 0 && this->limbs[words - 1] == 0)
+        --words;
+    this->resize(words);
+}
+
+void mapped_uInt::advise(const int& advice) const {
+    if (this->limbs != nullptr)
+        madvise(this->limbs, this->length * sizeof(uint64_t), advice);
+}
+
+// ============================== Public Methods ==============================
+
+// =============================== Constructors ===============================
+
+// Opens the number stored at path, creating an empty file (a value of 0) if
+// it does not exist yet. The destructor does not run for a constructor which
+// throws, so the file is closed here if it cannot be mapped.
+mapped_uInt::mapped_uInt(const std::string& file)
+        : path(file), fd(-1), limbs(nullptr), length(0) {
+    this->fd = open(file.c_str(), O_RDWR | O_CREAT, 0644);
+    this->check(this->fd != -1, "open");
+    try {
+        struct stat info;
+        this->check(fstat(this->fd, &info) == 0, "stat");
+        if (info.st_size % sizeof(uint64_t) != 0) {
+            throw std::runtime_error("ERROR: " + file + " is not a whole number of words");
+        }
+        this->length = info.st_size / sizeof(uint64_t);
+        this->resize(this->length);
+    } catch (...) {
+        close(this->fd);
+        throw;
+    }
+}
+
+mapped_uInt::mapped_uInt(const std::string& file, const uInt& n)
+        : mapped_uInt(file) {
+    *this = n;
+}
+
+mapped_uInt::mapped_uInt(mapped_uInt&& n)
+        : path(n.path), fd(n.fd), limbs(n.limbs), length(n.length) {
+    n.fd = -1;
+    n.limbs = nullptr;
+    n.length = 0;
+}
+
+mapped_uInt::~mapped_uInt() {
+    if (this->limbs != nullptr)
+        munmap(this->limbs, this->length * sizeof(uint64_t));
+    if (this->fd != -1)
+        close(this->fd);
+}
+
+// ================================ Assignment ================================
+
+mapped_uInt& mapped_uInt::operator=(const uInt& n) {
+    std::vector<uint64_t> words = to_words(n);
+    this->resize(0);
+    this->resize(words.size());
+    std::copy(words.begin(), words.end(), this->limbs);
+    return *this;
+}
+
+// Adds one block of words at a time, carrying between blocks, so both
+// operands are read front to back exactly once.
+mapped_uInt& mapped_uInt::operator+=(const mapped_uInt& n) {
+    uint64_t longest = this->length > n.length ? this->length : n.length;
+    this->resize(longest + 1);
+    this->advise(MADV_SEQUENTIAL);
+    n.advise(MADV_SEQUENTIAL);
+    bool carry = false;
+    for (uint64_t block = 0; block < longest; block += MAPPED_BLOCK_WORDS) {
+        uint64_t end = block + MAPPED_BLOCK_WORDS < longest
+            ? block + MAPPED_BLOCK_WORDS : longest;
+        for (uint64_t i = block; i < end; ++i) {
+            uint64_t addend = i < n.length ? n.limbs[i] : 0;
+            uint64_t sum = this->limbs[i] + addend;
+            bool next = sum < addend;
+            this->limbs[i] = sum + carry;
+            carry = next || this->limbs[i] < sum;
+        }
+    }
+    this->limbs[longest] = carry;
+    this->advise(MADV_NORMAL);
+    n.advise(MADV_NORMAL);
+    this->normalize();
+    return *this;
+}
+
+// Sets this to a * b with words_mul_into straight on the mapped words, so
+// large factors use Karatsuba's method. Its scratch space lives in an
+// unlinked file next to this one, about four times the length of the shorter
+// factor, so nothing but the pages being worked on has to be resident. Each
+// level of recursion works on contiguous halves of its operands, so the pages
+// touched stay local once the halves are small enough to fit in memory.
+void mapped_uInt::multiply(const mapped_uInt& a, const mapped_uInt& b) {
+    if (this == &a || this == &b) {
+        throw std::runtime_error("ERROR: The product cannot be stored in one of its factors");
+    }
+    this->resize(0);
+    if (a.length == 0 || b.length == 0) return;
+    const mapped_uInt& longer = a.length >= b.length ? a : b;
+    const mapped_uInt& shorter = a.length >= b.length ? b : a;
+    this->resize(a.length + b.length);
+    uint64_t words = words_mul_scratch(longer.length, shorter.length);
+    if (words == 0) {
+        words_mul_into(longer.limbs, longer.length, shorter.limbs, shorter.length,
+            this->limbs, nullptr);
+    } else {
+        std::string name = this->path + ".XXXXXX";
+        int scratch_fd = mkstemp(&name[0]);
+        this->check(scratch_fd != -1, "create a scratch file for");
+        close(scratch_fd);
+        mapped_uInt scratch(name);
+        unlink(name.c_str());
+        scratch.resize(words);
+        words_mul_into(longer.limbs, longer.length, shorter.limbs, shorter.length,
+            this->limbs, scratch.limbs);
+    }
+    this->normalize();
+}
+
+// ================================= Storage ==================================
+
+// The number of 64 bit words in the file.
+uint64_t mapped_uInt::size() const {
+    return this->length;
+}
+
+const uint64_t* mapped_uInt::data() const {
+    return this->limbs;
+}
+
+// Flushes the mapped words back to the file.
+void mapped_uInt::sync() const {
+    if (this->limbs != nullptr)
+        this->check(msync(this->limbs, this->length * sizeof(uint64_t), MS_SYNC) == 0, "sync");
+}
+
+// ================================= Casting ==================================
+
+mapped_uInt::operator uInt() const {
+    return from_words(std::vector<uint64_t>(this->limbs, this->limbs + this->length));
+}
+
+} // End namespace atn
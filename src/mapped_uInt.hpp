@@ -0,0 +1,58 @@
+// Written by Aaron Barge
+// Copyright 2020
+
+// A file backed counterpart to atn::uInt for operands which do not fit in
+// memory. The value is stored as 64 bit words, least significant word first
+// and in the host's byte order, in a file which is memory mapped while the
+// object is alive. The file holds nothing else, so a number written by one
+// run can be opened again by the next one. Addition walks the mapped words in
+// fixed size blocks so the kernel only has to keep a few pages of each operand
+// resident at a time. Multiplication uses Karatsuba's method, O(n^1.585) word
+// products, with its temporaries in a scratch file of about four times the
+// shorter factor created next to the product.
+
+#ifndef _UINTEGER_MAPPED_UINT_HPP_
+#define _UINTEGER_MAPPED_UINT_HPP_
+
+#include "uInt.hpp"
+
+namespace atn { // AaronTheNerd
+
+// ============================================================================
+// ============================== Predefinitions ==============================
+// ============================================================================
+
+class mapped_uInt {
+  private:
+    // =========================== Private Methods ============================
+    void check(const bool&, const std::string&) const;
+    void resize(const uint64_t&);
+    void normalize();
+    void advise(const int&) const;
+    std::string path;
+    int fd;
+    uint64_t* limbs;
+    uint64_t length;
+  public:
+    // ============================= Constructors =============================
+    explicit mapped_uInt(const std::string&);
+    mapped_uInt(const std::string&, const uInt&);
+    mapped_uInt(const mapped_uInt&) = delete;
+    mapped_uInt(mapped_uInt&&);
+    ~mapped_uInt();
+    // ============================== Assignment ==============================
+    mapped_uInt& operator=(const mapped_uInt&) = delete;
+    mapped_uInt& operator=(const uInt&);
+    mapped_uInt& operator+=(const mapped_uInt&);
+    void multiply(const mapped_uInt&, const mapped_uInt&);
+    // =============================== Storage ================================
+    uint64_t size() const;
+    const uint64_t* data() const;
+    void sync() const;
+    // =============================== Casting ================================
+    explicit operator uInt() const;
+};
+
+} // End namespace atn
+
+#endif // _UINTEGER_MAPPED_UINT_HPP_
@@ -0,0 +1,305 @@
+// Written by Aaron Barge
+// Copyright 2020
+
+#include "rns_uInt.hpp"
+#include <atomic> // std::atomic
+#include <thread> // std::thread
+
+// Bits contributed by each basis prime at the least, since every prime is
+// above 2^62.
+#define RNS_PRIME_BITS 62
+
+namespace atn { // AaronTheNerd
+
+// ============================================================================
+// =============================== Definitions ================================
+// ============================================================================
+
+// ============================= Helper Functions =============================
+
+namespace { // File local helpers
+
+// Montgomery reduction of t < p * 2^64, returning t * 2^-64 mod p. p is below
+// 2^63, so t + m * p cannot overflow 128 bits.
+uint64_t rns_reduce(const unsigned __int128& t, const uint64_t& p, const uint64_t& inverse) {
+    uint64_t m = uint64_t(t) * inverse;
+    uint64_t u = uint64_t((t + (unsigned __int128)m * p) >> 64);
+    return u >= p ? u - p : u;
+}
+
+// The inverse of a modulo the prime p by the extended Euclidean algorithm.
+// Every cofactor is at most p in magnitude, so they fit in an int64_t.
+uint64_t rns_inverse(uint64_t a, const uint64_t& p) {
+    uint64_t b = p;
+    int64_t x = 1, y = 0;
+    while (b != 0) {
+        uint64_t q = a / b;
+        a -= q * b;
+        std::swap(a, b);
+        x -= int64_t(q) * y;
+        std::swap(x, y);
+    }
+    return x < 0 ? uint64_t(x + int64_t(p)) : uint64_t(x);
+}
+
+// Spreads count jobs over the given number of threads (all hardware threads
+// by default), each claiming the next job, as probable_primes does.
+template <typename Job>
+void rns_parallel(const uint64_t& count, uint64_t threads, const Job& job) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    if (threads > count) threads = count;
+    std::atomic<uint64_t> next(0);
+    std::vector<std::thread> workers;
+    for (uint64_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            for (uint64_t i = next++; i < count; i = next++)
+                job(i);
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+}
+
+} // End anonymous namespace
+
+// ================================ rns_basis =================================
+
+// Chooses the largest primes below 2^63 until their product is at least
+// 2^bits, so every value below 2^bits has a unique representation.
+rns_basis::rns_basis(const uint64_t& bits) {
+    uint64_t count = bits / RNS_PRIME_BITS + 1;
+    for (uint64_t candidate = (uint64_t(1) << 63) - 1; this->primes.size() < count; candidate -= 2) {
+        if (is_probable_prime(uInt(candidate)))
+            this->primes.emplace_back(candidate);
+    }
+    this->inverses.resize(count);
+    this->r_squared.resize(count);
+    this->garner.resize(count * (count - 1) / 2);
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t p = this->primes[i], inverse = p;
+        for (uint64_t k = 0; k < 5; ++k)
+            inverse *= 2 - p * inverse; // Newton's iteration doubles the correct bits
+        this->inverses[i] = -inverse;
+        uint64_t r = (negative_one % p + 1) % p;
+        this->r_squared[i] = uint64_t((unsigned __int128)r * r % p);
+        uint64_t* row = this->garner.data() + i * (i - 1) / 2;
+        for (uint64_t j = 0; j < i; ++j) {
+            uint64_t inverse_j = rns_inverse(this->primes[j] % p, p);
+            row[j] = uint64_t((unsigned __int128)inverse_j * r % p);
+        }
+    }
+}
+
+// The number of primes in the basis.
+uint64_t rns_basis::size() const {
+    return this->primes.size();
+}
+
+// Every value below 2^bits() can be represented and read back.
+uint64_t rns_basis::bits() const {
+    return this->primes.size() * RNS_PRIME_BITS;
+}
+
+uint64_t rns_basis::prime(const uint64_t& i) const {
+    return this->primes[i];
+}
+
+// ============================= Private Methods ==============================
+
+void rns_uInt::check_basis(const rns_uInt& n) const {
+    if (this->basis != n.basis) {
+        throw std::runtime_error("ERROR: The values use different RNS bases");
+    }
+}
+
+// Returns num mod prime i in Montgomery form.
+uint64_t rns_uInt::to_form(const uint64_t& num, const uint64_t& i) const {
+    const rns_basis& b = *this->basis;
+    return rns_reduce((unsigned __int128)(num % b.primes[i]) * b.r_squared[i],
+        b.primes[i], b.inverses[i]);
+}
+
+// ============================== Public Methods ==============================
+
+// =============================== Constructors ===============================
+
+rns_uInt::rns_uInt(const std::shared_ptr<const rns_basis>& b)
+        : basis(b), residues(b->size(), 0) {}
+
+rns_uInt::rns_uInt(const std::shared_ptr<const rns_basis>& b, const uint64_t& num)
+        : basis(b), residues(b->size()) {
+    for (uint64_t i = 0; i < this->residues.size(); ++i)
+        this->residues[i] = this->to_form(num, i);
+}
+
+// Reduces n by every prime with Horner's rule from the top word down. Each
+// step multiplies by 2^64 with one Montgomery multiplication by 2^128.
+rns_uInt::rns_uInt(const std::shared_ptr<const rns_basis>& b, const uInt_view& n)
+        : basis(b), residues(b->size()) {
+    std::vector<uint64_t> words((n.bit_length() + 63) >> 6);
+    for (uint64_t j = 0; j < words.size(); ++j)
+        words[j] = n.word(j);
+    for (uint64_t i = 0; i < this->residues.size(); ++i) {
+        uint64_t p = b->primes[i], inverse = b->inverses[i], r2 = b->r_squared[i];
+        uint64_t remainder = 0;
+        for (uint64_t j = words.size() - 1; j != negative_one; --j) {
+            remainder = rns_reduce((unsigned __int128)remainder * r2, p, inverse);
+            uint64_t word = words[j];
+            while (word >= p)
+                word -= p; // at most three times since p > 2^62
+            remainder += word;
+            if (remainder >= p) remainder -= p;
+        }
+        this->residues[i] = rns_reduce((unsigned __int128)remainder * r2, p, inverse);
+    }
+}
+
+// ================================ Assignment ================================
+
+// Residues are below p < 2^63, so a sum never overflows and a difference
+// below zero is negative as an int64_t. The sign picks whether to add p back
+// without a branch.
+
+rns_uInt& rns_uInt::operator+=(const rns_uInt& n) {
+    this->check_basis(n);
+    const uint64_t* primes = this->basis->primes.data();
+    for (uint64_t i = 0; i < this->residues.size(); ++i) {
+        uint64_t sum = this->residues[i] + n.residues[i] - primes[i];
+        this->residues[i] = sum + (primes[i] & uint64_t(int64_t(sum) >> 63));
+    }
+    return *this;
+}
+
+rns_uInt& rns_uInt::operator-=(const rns_uInt& n) {
+    this->check_basis(n);
+    const uint64_t* primes = this->basis->primes.data();
+    for (uint64_t i = 0; i < this->residues.size(); ++i) {
+        uint64_t difference = this->residues[i] - n.residues[i];
+        this->residues[i] = difference + (primes[i] & uint64_t(int64_t(difference) >> 63));
+    }
+    return *this;
+}
+
+rns_uInt& rns_uInt::operator*=(const rns_uInt& n) {
+    this->check_basis(n);
+    const rns_basis& b = *this->basis;
+    for (uint64_t i = 0; i < this->residues.size(); ++i) {
+        this->residues[i] = rns_reduce((unsigned __int128)this->residues[i] * n.residues[i],
+            b.primes[i], b.inverses[i]);
+    }
+    return *this;
+}
+
+rns_uInt& rns_uInt::operator+=(const uint64_t& num) {
+    return *this += rns_uInt(this->basis, num);
+}
+
+rns_uInt& rns_uInt::operator-=(const uint64_t& num) {
+    return *this -= rns_uInt(this->basis, num);
+}
+
+rns_uInt& rns_uInt::operator*=(const uint64_t& num) {
+    return *this *= rns_uInt(this->basis, num);
+}
+
+// ================================ Arithmetic ================================
+
+rns_uInt rns_uInt::operator+(const rns_uInt& n) const {
+    rns_uInt result = *this;
+    result += n;
+    return result;
+}
+
+rns_uInt rns_uInt::operator-(const rns_uInt& n) const {
+    rns_uInt result = *this;
+    result -= n;
+    return result;
+}
+
+rns_uInt rns_uInt::operator*(const rns_uInt& n) const {
+    rns_uInt result = *this;
+    result *= n;
+    return result;
+}
+
+// =============================== Conditional ================================
+
+// Values below M are equal exactly when all of their residues are.
+
+bool rns_uInt::operator==(const rns_uInt& n) const {
+    this->check_basis(n);
+    return this->residues == n.residues;
+}
+
+bool rns_uInt::operator!=(const rns_uInt& n) const {
+    return !(*this == n);
+}
+
+// ================================= Storage ==================================
+
+// The value modulo basis prime i.
+uint64_t rns_uInt::residue(const uint64_t& i) const {
+    const rns_basis& b = *this->basis;
+    return rns_reduce(this->residues[i], b.primes[i], b.inverses[i]);
+}
+
+// ================================= Casting ==================================
+
+// Garner's algorithm. The mixed radix digits v_i, with
+// x = v_0 + v_1 p_0 + v_2 p_0 p_1 + ..., are found one prime at a time using
+// the precomputed inverses p_j^-1 mod p_i, then x is rebuilt from the top
+// digit down with one word multiplication pass per prime.
+rns_uInt::operator uInt() const {
+    const rns_basis& b = *this->basis;
+    uint64_t count = this->residues.size();
+    std::vector<uint64_t> digits(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t p = b.primes[i], inverse = b.inverses[i];
+        const uint64_t* row = b.garner.data() + i * (i - 1) / 2;
+        uint64_t t = rns_reduce(this->residues[i], p, inverse);
+        for (uint64_t j = 0; j < i; ++j) {
+            uint64_t digit = digits[j] >= p ? digits[j] - p : digits[j];
+            t = t >= digit ? t - digit : t + (p - digit);
+            t = rns_reduce((unsigned __int128)t * row[j], p, inverse);
+        }
+        digits[i] = t;
+    }
+    std::vector<uint64_t> words(1, digits[count - 1]);
+    for (uint64_t i = count - 2; i != negative_one; --i) {
+        unsigned __int128 carry = digits[i];
+        for (uint64_t j = 0; j < words.size(); ++j) {
+            carry += (unsigned __int128)words[j] * b.primes[i];
+            words[j] = uint64_t(carry);
+            carry >>= 64;
+        }
+        if (carry != 0) words.emplace_back(uint64_t(carry));
+    }
+    words_normalize(words);
+    return from_words(words);
+}
+
+// =========================== Non-Class Functions ============================
+
+// Converts every value into the basis, spread over the given number of
+// threads (all hardware threads by default).
+std::vector<rns_uInt> to_rns(const std::shared_ptr<const rns_basis>& basis,
+        const std::vector<uInt>& values, uint64_t threads) {
+    std::vector<rns_uInt> result(values.size(), rns_uInt(basis));
+    rns_parallel(values.size(), threads, [&](const uint64_t& i) {
+        result[i] = rns_uInt(basis, values[i]);
+    });
+    return result;
+}
+
+// Converts every value back to an atn::uInt, spread over the given number of
+// threads (all hardware threads by default).
+std::vector<uInt> from_rns(const std::vector<rns_uInt>& values, uint64_t threads) {
+    std::vector<uInt> result(values.size());
+    rns_parallel(values.size(), threads, [&](const uint64_t& i) {
+        result[i] = uInt(values[i]);
+    });
+    return result;
+}
+
+} // End namespace atn
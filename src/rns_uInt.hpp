@@ -0,0 +1,89 @@
+// Written by Aaron Barge
+// Copyright 2020
+
+// A residue number system counterpart to atn::uInt for long chains of
+// additions, subtractions and multiplications. A value is held as its
+// residues modulo a basis of primes between 2^62 and 2^63, so every operation
+// works on each residue on its own: no carry ever crosses from one residue to
+// the next and multiplication is one word product per prime. Additions and
+// subtractions are branch free so the compiler can vectorize them, and
+// separate values, or separate residues of one value, can be worked on from
+// different threads. Converting back to an atn::uInt uses Garner's algorithm.
+//
+// Arithmetic is exact modulo the product M of the basis primes. A result is
+// only read back correctly when it is below M, which is at least
+// 2^rns_basis::bits(), and a subtraction which would go below zero wraps
+// around modulo M.
+
+#ifndef _UINTEGER_RNS_UINT_HPP_
+#define _UINTEGER_RNS_UINT_HPP_
+
+#include "uInt.hpp"
+#include <memory> // std::shared_ptr
+
+namespace atn { // AaronTheNerd
+
+// ============================================================================
+// ============================== Predefinitions ==============================
+// ============================================================================
+
+// The primes of a residue number system and the constants needed to convert
+// to and from it. Residues are stored in Montgomery form, x * 2^64 mod p, so
+// multiplying two of them never needs a division.
+class rns_basis {
+  private:
+    friend class rns_uInt;
+    std::vector<uint64_t> primes;
+    std::vector<uint64_t> inverses; // -p^-1 mod 2^64
+    std::vector<uint64_t> r_squared; // 2^128 mod p
+    std::vector<uint64_t> garner; // p_j^-1 mod p_i in Montgomery form, row i holds j < i
+  public:
+    // ============================= Constructors =============================
+    explicit rns_basis(const uint64_t&);
+    // =============================== Storage ================================
+    uint64_t size() const;
+    uint64_t bits() const;
+    uint64_t prime(const uint64_t&) const;
+};
+
+class rns_uInt {
+  private:
+    // =========================== Private Methods ============================
+    void check_basis(const rns_uInt&) const;
+    uint64_t to_form(const uint64_t&, const uint64_t&) const;
+    std::shared_ptr<const rns_basis> basis;
+    std::vector<uint64_t> residues;
+  public:
+    // ============================= Constructors =============================
+    explicit rns_uInt(const std::shared_ptr<const rns_basis>&);
+    rns_uInt(const std::shared_ptr<const rns_basis>&, const uint64_t&);
+    rns_uInt(const std::shared_ptr<const rns_basis>&, const uInt_view&);
+    // ============================== Assignment ==============================
+    rns_uInt& operator+=(const rns_uInt&);
+    rns_uInt& operator-=(const rns_uInt&);
+    rns_uInt& operator*=(const rns_uInt&);
+    rns_uInt& operator+=(const uint64_t&);
+    rns_uInt& operator-=(const uint64_t&);
+    rns_uInt& operator*=(const uint64_t&);
+    // ============================== Arithmetic ==============================
+    rns_uInt operator+(const rns_uInt&) const;
+    rns_uInt operator-(const rns_uInt&) const;
+    rns_uInt operator*(const rns_uInt&) const;
+    // ============================= Conditional ==============================
+    bool operator==(const rns_uInt&) const;
+    bool operator!=(const rns_uInt&) const;
+    // =============================== Storage ================================
+    uint64_t residue(const uint64_t&) const;
+    // =============================== Casting ================================
+    explicit operator uInt() const;
+};
+
+// =========================== Non-Class Functions ============================
+
+std::vector<rns_uInt> to_rns(const std::shared_ptr<const rns_basis>&,
+    const std::vector<uInt>&, uint64_t = 0);
+std::vector<uInt> from_rns(const std::vector<rns_uInt>&, uint64_t = 0);
+
+} // End namespace atn
+
+#endif // _UINTEGER_RNS_UINT_HPP_
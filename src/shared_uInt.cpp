@@ -0,0 +1,190 @@
+// Written by Aaron Barge
+// Copyright 2020
+
+#include "shared_uInt.hpp"
+#include <atomic> // std::atomic_thread_fence
+
+namespace atn { // AaronTheNerd
+
+// ============================================================================
+// =============================== Definitions ================================
+// ============================================================================
+
+// ============================= Private Methods ==============================
+
+// Returns a value which only this handle refers to, cloning the shared one
+// first if needed. use_count() is a relaxed load, so when it reports this
+// handle as the only owner the fence orders the changes after the reads
+// another thread made before it released its handle.
+uInt& shared_uInt::mutate() {
+    if (this->value.use_count() != 1)
+        this->value = std::make_shared<uInt>(*this->value);
+    else
+        std::atomic_thread_fence(std::memory_order_acquire);
+    return *this->value;
+}
+
+// ============================== Public Methods ==============================
+
+// =============================== Constructors ===============================
+
+shared_uInt::shared_uInt() : value(std::make_shared<uInt>()) {}
+
+shared_uInt::shared_uInt(const uint64_t& num) : value(std::make_shared<uInt>(num)) {}
+
+shared_uInt::shared_uInt(const uInt& n) : value(std::make_shared<uInt>(n)) {}
+
+shared_uInt::shared_uInt(uInt&& n) : value(std::make_shared<uInt>(std::move(n))) {}
+
+shared_uInt::shared_uInt(const std::string& str) : value(std::make_shared<uInt>(str)) {}
+
+// ================================= Storage ==================================
+
+const uInt& shared_uInt::get() const {
+    return *this->value;
+}
+
+shared_uInt::operator const uInt&() const {
+    return *this->value;
+}
+
+// The number of handles sharing this handle's value, including itself.
+uint64_t shared_uInt::use_count() const {
+    return this->value.use_count();
+}
+
+bool shared_uInt::shares_storage(const shared_uInt& n) const {
+    return this->value == n.value;
+}
+
+// ================================ To String =================================
+
+std::string shared_uInt::to_string() const {
+    return this->value->to_string();
+}
+
+std::string shared_uInt::to_string(const uint64_t& base) const {
+    return this->value->to_string(base);
+}
+
+// ================================ Assignment ================================
+
+// n may refer to this handle's own value. If that value is shared, mutate()
+// clones it and n still refers to the untouched original.
+
+shared_uInt& shared_uInt::operator+=(const uInt& n) {
+    this->mutate() += n;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator-=(const uInt& n) {
+    this->mutate() -= n;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator*=(const uInt& n) {
+    this->mutate() *= n;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator/=(const uInt& n) {
+    this->mutate() /= n;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator%=(const uInt& n) {
+    this->mutate() %= n;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator<<=(const uint64_t& pos) {
+    this->mutate() <<= pos;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator>>=(const uint64_t& pos) {
+    this->mutate() >>= pos;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator&=(const uInt& n) {
+    this->mutate() &= n;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator|=(const uInt& n) {
+    this->mutate() |= n;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator^=(const uInt& n) {
+    this->mutate() ^= n;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator+=(const uint64_t& num) {
+    this->mutate() += num;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator-=(const uint64_t& num) {
+    this->mutate() -= num;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator*=(const uint64_t& num) {
+    this->mutate() *= num;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator/=(const uint64_t& num) {
+    this->mutate() /= num;
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator%=(const uint64_t& num) {
+    this->mutate() %= num;
+    return *this;
+}
+
+// ================================== Unary ===================================
+
+shared_uInt& shared_uInt::operator++() {
+    ++this->mutate();
+    return *this;
+}
+
+shared_uInt& shared_uInt::operator--() {
+    --this->mutate();
+    return *this;
+}
+
+// =============================== Conditional ================================
+
+// Handles which share a value are equal without comparing any bits.
+
+bool shared_uInt::operator==(const shared_uInt& n) const {
+    return this->value == n.value || *this->value == *n.value;
+}
+
+bool shared_uInt::operator!=(const shared_uInt& n) const {
+    return this->value != n.value && *this->value != *n.value;
+}
+
+bool shared_uInt::operator<(const shared_uInt& n) const {
+    return this->value != n.value && *this->value < *n.value;
+}
+
+bool shared_uInt::operator>(const shared_uInt& n) const {
+    return this->value != n.value && *this->value > *n.value;
+}
+
+bool shared_uInt::operator<=(const shared_uInt& n) const {
+    return this->value == n.value || *this->value <= *n.value;
+}
+
+bool shared_uInt::operator>=(const shared_uInt& n) const {
+    return this->value == n.value || *this->value >= *n.value;
+}
+
+} // End namespace atn
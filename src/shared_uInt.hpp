@@ -0,0 +1,75 @@
+// Written by Aaron Barge
+// Copyright 2020
+
+// A copy on write handle to an atn::uInt. Copies of a shared_uInt share one
+// reference counted value, so copying one, storing it in a container or
+// returning it is O(1) no matter how large the value is. The first change
+// made through a handle whose value is shared clones the value for that
+// handle alone. The reference count is a std::shared_ptr's, so handles which
+// share a value may be copied, changed and destroyed from different threads
+// at once. As with any other object, a single handle must not be changed by
+// one thread while another thread uses it.
+
+#ifndef _UINTEGER_SHARED_UINT_HPP_
+#define _UINTEGER_SHARED_UINT_HPP_
+
+#include "uInt.hpp"
+#include <memory> // std::shared_ptr, std::make_shared
+
+namespace atn { // AaronTheNerd
+
+// ============================================================================
+// ============================== Predefinitions ==============================
+// ============================================================================
+
+class shared_uInt {
+  private:
+    // =========================== Private Methods ============================
+    uInt& mutate();
+    std::shared_ptr<uInt> value;
+  public:
+    // ============================= Constructors =============================
+    shared_uInt();
+    shared_uInt(const uint64_t&);
+    shared_uInt(const uInt&);
+    shared_uInt(uInt&&);
+    explicit shared_uInt(const std::string&);
+    // =============================== Storage ================================
+    const uInt& get() const;
+    operator const uInt&() const;
+    uint64_t use_count() const;
+    bool shares_storage(const shared_uInt&) const;
+    // ============================== To String ===============================
+    std::string to_string() const;
+    std::string to_string(const uint64_t&) const;
+    // ============================== Assignment ==============================
+    shared_uInt& operator+=(const uInt&);
+    shared_uInt& operator-=(const uInt&);
+    shared_uInt& operator*=(const uInt&);
+    shared_uInt& operator/=(const uInt&);
+    shared_uInt& operator%=(const uInt&);
+    shared_uInt& operator<<=(const uint64_t&);
+    shared_uInt& operator>>=(const uint64_t&);
+    shared_uInt& operator&=(const uInt&);
+    shared_uInt& operator|=(const uInt&);
+    shared_uInt& operator^=(const uInt&);
+    shared_uInt& operator+=(const uint64_t&);
+    shared_uInt& operator-=(const uint64_t&);
+    shared_uInt& operator*=(const uint64_t&);
+    shared_uInt& operator/=(const uint64_t&);
+    shared_uInt& operator%=(const uint64_t&);
+    // ================================ Unary =================================
+    shared_uInt& operator++();
+    shared_uInt& operator--();
+    // ============================= Conditional ==============================
+    bool operator==(const shared_uInt&) const;
+    bool operator!=(const shared_uInt&) const;
+    bool operator<(const shared_uInt&) const;
+    bool operator>(const shared_uInt&) const;
+    bool operator<=(const shared_uInt&) const;
+    bool operator>=(const shared_uInt&) const;
+};
+
+} // End namespace atn
+
+#endif // _UINTEGER_SHARED_UINT_HPP_
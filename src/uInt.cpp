@@ -0,0 +1,3049 @@
+// Written by Aaron Barge
+// Copyright 2020
+
+// The definitions of everything declared in uInt.hpp except the word kernels,
+// which are in word_kernels.cpp so they can be compiled with their own flags.
+
+#include "uInt.hpp"
+#include <atomic> // std::atomic
+#include <cstring> // std::memcpy
+#include <thread> // std::thread
+#if defined(PERFORMANCE_TEST) && defined(HARDWARE_COUNTERS)
+    #include <linux/perf_event.h> // perf_event_attr
+    #include <sys/syscall.h> // SYS_perf_event_open
+    #include <unistd.h> // syscall, read, close
+#endif
+
+// ====================== Performance Testing Variables =======================
+
+#ifdef PERFORMANCE_TEST
+namespace atn { // AaronTheNerd
+
+#ifdef HARDWARE_COUNTERS
+hardware_counter_group::hardware_counter_group() : members(0) {
+    const uint32_t types[NUM_OF_HARDWARE_COUNTERS] = { PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE };
+    const uint64_t configs[NUM_OF_HARDWARE_COUNTERS] = { PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_L1D
+            | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+    int leader = -1;
+    for (uint64_t i = 0; i < NUM_OF_HARDWARE_COUNTERS; ++i) {
+        perf_event_attr attr = perf_event_attr();
+        attr.size = sizeof(perf_event_attr);
+        attr.type = types[i];
+        attr.config = configs[i];
+        attr.read_format = PERF_FORMAT_GROUP;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        this->fds[i] = int(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+        this->opened[i] = this->fds[i] != -1;
+        if (!this->opened[i]) continue;
+        if (leader == -1) leader = this->fds[i];
+        this->order[i] = this->members++;
+    }
+}
+
+hardware_counter_group::~hardware_counter_group() {
+    for (uint64_t i = 0; i < NUM_OF_HARDWARE_COUNTERS; ++i) {
+        if (this->opened[i]) close(this->fds[i]);
+    }
+}
+
+bool hardware_counter_group::available() const {
+    return this->members != 0;
+}
+
+// Reads the current value of every counter, leaving unopened counters at 0.
+void hardware_counter_group::read_values(uint64_t* values) const {
+    uint64_t buffer[NUM_OF_HARDWARE_COUNTERS + 1] = {};
+    int leader = -1;
+    for (uint64_t i = 0; i < NUM_OF_HARDWARE_COUNTERS && leader == -1; ++i) {
+        if (this->opened[i]) leader = this->fds[i];
+    }
+    if (read(leader, buffer, sizeof(buffer)) <= 0) buffer[0] = 0;
+    for (uint64_t i = 0; i < NUM_OF_HARDWARE_COUNTERS; ++i) {
+        values[i] = this->opened[i] && this->order[i] < buffer[0]
+            ? buffer[this->order[i] + 1] : 0;
+    }
+}
+#endif
+
+namespace { // File local helpers
+
+#ifdef MEMORY_ACCOUNTING
+// Set once this thread's counters are destroyed, after which uInts that are
+// still being freed (globals such as ONE) only update the process totals.
+thread_local bool performance_counters_destroyed = false;
+#endif
+
+// Every live thread's counters plus the totals of threads which have exited,
+// and the clock readings used to convert ticks into time.
+struct performance_registry {
+    std::mutex lock;
+    std::vector<thread_performance_counters*> threads;
+    std::vector<operation_totals> retired;
+    #ifdef HARDWARE_COUNTERS
+        bool hardware_opened[NUM_OF_HARDWARE_COUNTERS] = {};
+    #endif
+    #ifdef MEMORY_ACCOUNTING
+        // Every allocation of uInt storage, whether or not an operation was running
+        std::atomic<uint64_t> allocations;
+        std::atomic<uint64_t> allocated_bytes;
+        std::atomic<uint64_t> freed_bytes;
+        std::atomic<int64_t> live_bytes;
+        std::atomic<int64_t> peak_bytes;
+    #endif
+    uint64_t first_tick;
+    std::chrono::steady_clock::time_point first_time;
+    performance_registry() : retired(NUM_OF_TESTS, operation_totals()),
+        #ifdef MEMORY_ACCOUNTING
+            allocations(0), allocated_bytes(0), freed_bytes(0), live_bytes(0), peak_bytes(0),
+        #endif
+        first_tick(performance_ticks()), first_time(std::chrono::steady_clock::now()) {}
+};
+
+performance_registry& get_performance_registry() {
+    static performance_registry registry;
+    return registry;
+}
+
+// Nanoseconds per tick, measured over the life of the program so far.
+double performance_tick_length() {
+    #if defined(__x86_64__)
+        performance_registry& registry = get_performance_registry();
+        uint64_t ticks = performance_ticks() - registry.first_tick;
+        std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - registry.first_time;
+        return ticks == 0 ? 0.0 : elapsed.count() / ticks;
+    #else
+        return 1.0;
+    #endif
+}
+
+void add_counters(std::vector<operation_totals>& totals,
+        const thread_performance_counters& counters, const double& tick_length) {
+    for (uint64_t i = 0; i < NUM_OF_TESTS; ++i) {
+        const operation_counters& op = counters.operations[i];
+        totals[i].calls += op.calls.load(std::memory_order_relaxed);
+        totals[i].milliseconds += op.ticks.load(std::memory_order_relaxed) * tick_length / 1e6;
+        totals[i].bytes += op.bytes.load(std::memory_order_relaxed);
+        for (uint64_t t = 0; t < NUM_OF_TIERS; ++t) {
+            for (uint64_t b = 0; b < SIZE_BUCKETS; ++b)
+                totals[i].sizes[t][b] += op.sizes[t][b].load(std::memory_order_relaxed);
+        }
+        #ifdef HARDWARE_COUNTERS
+            for (uint64_t b = 0; b < SIZE_BUCKETS; ++b) {
+                for (uint64_t c = 0; c < NUM_OF_HARDWARE_COUNTERS; ++c)
+                    totals[i].hardware[b][c] += op.hardware[b][c].load(std::memory_order_relaxed);
+            }
+        #endif
+        #ifdef MEMORY_ACCOUNTING
+            totals[i].allocations += op.allocations.load(std::memory_order_relaxed);
+            totals[i].allocated_bytes += op.allocated_bytes.load(std::memory_order_relaxed);
+            totals[i].freed_bytes += op.freed_bytes.load(std::memory_order_relaxed);
+            uint64_t peak = op.peak_bytes.load(std::memory_order_relaxed);
+            if (peak > totals[i].peak_bytes) totals[i].peak_bytes = peak;
+        #endif
+    }
+}
+
+} // End anonymous namespace
+
+thread_performance_counters::thread_performance_counters() : operations(), depth()
+        #ifdef MEMORY_ACCOUNTING
+            , current(NUM_OF_TESTS), live_bytes(0), high_bytes(0)
+        #endif
+        {
+    performance_registry& registry = get_performance_registry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    registry.threads.emplace_back(this);
+    #ifdef HARDWARE_COUNTERS
+        for (uint64_t c = 0; c < NUM_OF_HARDWARE_COUNTERS; ++c)
+            registry.hardware_opened[c] |= this->hardware.opened[c];
+    #endif
+}
+
+thread_performance_counters::~thread_performance_counters() {
+    #ifdef MEMORY_ACCOUNTING
+        performance_counters_destroyed = true;
+    #endif
+    performance_registry& registry = get_performance_registry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    add_counters(registry.retired, *this, performance_tick_length());
+    for (auto it = registry.threads.begin(); it != registry.threads.end(); ++it) {
+        if (*it == this) {
+            registry.threads.erase(it);
+            break;
+        }
+    }
+}
+
+thread_local thread_performance_counters performance_counters;
+
+#ifdef MEMORY_ACCOUNTING
+
+void account_memory(const int64_t& bytes) {
+    performance_registry& registry = get_performance_registry();
+    if (bytes > 0) {
+        registry.allocations.fetch_add(1, std::memory_order_relaxed);
+        registry.allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    } else {
+        registry.freed_bytes.fetch_add(-bytes, std::memory_order_relaxed);
+    }
+    int64_t live = registry.live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    int64_t peak = registry.peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !registry.peak_bytes.compare_exchange_weak(peak, live,
+        std::memory_order_relaxed)) {}
+    if (performance_counters_destroyed) return;
+    thread_performance_counters& counters = performance_counters;
+    counters.live_bytes += bytes;
+    if (counters.live_bytes > counters.high_bytes) counters.high_bytes = counters.live_bytes;
+    if (counters.current == NUM_OF_TESTS) return;
+    operation_counters& op = counters.operations[counters.current];
+    if (bytes > 0) {
+        add_relaxed(op.allocations, 1);
+        add_relaxed(op.allocated_bytes, bytes);
+    } else {
+        add_relaxed(op.freed_bytes, -bytes);
+    }
+}
+#endif
+
+} // End namespace atn
+#endif
+
+namespace atn { // AaronTheNerd
+
+// ============================= Helper Functions =============================
+
+namespace { // File local helpers
+
+// Writes a base 10^19 digit as exactly 19 decimal characters.
+void write_decimal_block(uint64_t block, char* buffer) {
+    for (uint64_t i = DECIMAL_BLOCK_DIGITS - 1; i != negative_one; --i) {
+        buffer[i] = char('0' + block % 10);
+        block /= 10;
+    }
+}
+
+// Returns the value of a digit in the given base or negative_one if c is not
+// a digit of that base. Bases up to 36 ignore case, base 64 uses
+// base64_index.
+uint64_t digit_value(const char& c, const uint64_t& base) {
+    uint64_t value = negative_one;
+    if (base == 64u) {
+        if ('A' <= c && c <= 'Z') value = c - 'A';
+        else if ('a' <= c && c <= 'z') value = c - 'a' + 26;
+        else if ('0' <= c && c <= '9') value = c - '0' + 52;
+        else if (c == '+') value = 62;
+        else if (c == '/') value = 63;
+        return value;
+    }
+    if ('0' <= c && c <= '9') value = c - '0';
+    else if ('a' <= c && c <= 'z') value = c - 'a' + 10;
+    else if ('A' <= c && c <= 'Z') value = c - 'A' + 10;
+    return value < base ? value : negative_one;
+}
+
+} // End anonymous namespace
+
+// ============================================================================
+// =============================== Definitions ================================
+// ============================================================================
+
+// ============================= Private Methods ==============================
+
+// Performs a simultaneous division and modulo operation and returns a pair
+// containing the results where the first item in the pair is an atn::uInt
+// representing the result of the division and the second is an atn::uInt
+// representing the result of the modulo.
+std::pair<uInt, uInt> uInt::div_and_mod(const uInt& n) const {
+    /*
+    Potential micro optimizations
+    1. Iterator vs. **uint64_t index**
+    2. Setting the quotient's value to `mod >= n` vs. **to true or false.**
+    3. Adding quotient[i] / *it's value to mod directly vs. **if statement**
+    */
+    if (n == ZERO) {
+        throw std::runtime_error("ERROR: Divide/Mod by 0 Exception");
+    }
+    if (this->bits.size() == 0) {
+        return std::make_pair(*this, *this);
+    }
+    uInt quotient(*this), mod;
+    for (uint64_t i = quotient.bits.size() - 1; i != negative_one; --i) {
+        mod <<= 1;
+        if (quotient.bits[i]) ++mod;
+        if (mod >= n) {
+            quotient.bits[i] = true;
+            mod -= n;
+        } else {
+            quotient.bits[i] = false;
+        }
+    }
+    mod.remove_lead_zeros();
+    quotient.remove_lead_zeros();
+    return std::make_pair(quotient, mod);
+}
+
+// Divides by a single word in place and returns the remainder. The
+// remainder always fits in a word, so each step is a word shift and compare
+// rather than an atn::uInt shift and compare, or with word access one
+// 128 by 64 bit division per word.
+uint64_t uInt::div_and_mod_word(const uint64_t& n) {
+    if (n == 0) {
+        throw std::runtime_error("ERROR: Divide/Mod by 0 Exception");
+    }
+    #ifdef WORD_ACCESS
+        uint64_t size = this->bits.size(), count = (size + 63) >> 6;
+        if (count == 0) return 0;
+        uint64_t* words = bit_words(this->bits);
+        if (size & 63) words[count - 1] &= (uint64_t(1) << (size & 63)) - 1;
+        unsigned __int128 mod = 0;
+        for (uint64_t i = count - 1; i != negative_one; --i) {
+            mod = (mod << 64) | words[i];
+            words[i] = uint64_t(mod / n);
+            mod %= n;
+        }
+    #else
+        uint64_t mod = 0;
+        for (uint64_t i = this->bits.size() - 1; i != negative_one; --i) {
+            bool overflow = mod >> 63;
+            mod = (mod << 1) | this->bits[i];
+            if (overflow || mod >= n) {
+                mod -= n;
+                this->bits[i] = true;
+            } else {
+                this->bits[i] = false;
+            }
+        }
+    #endif
+    this->remove_lead_zeros();
+    return uint64_t(mod);
+}
+
+// Returns the lowest 64 bits of the value.
+uint64_t uInt::low_word() const {
+    #ifdef WORD_ACCESS
+        return this->bits.empty() ? 0 : masked_word(this->bits, 0);
+    #else
+        uint64_t word = 0;
+        uint64_t end = this->bits.size() < 64 ? this->bits.size() : 64;
+        for (uint64_t i = end - 1; i != negative_one; --i)
+            word = (word << 1) | this->bits[i];
+        return word;
+    #endif
+}
+
+// Splits the value into base 10^19 digits, least significant first, so
+// decimal output only needs one word division per 19 digits.
+std::vector<uint64_t> uInt::decimal_blocks() const {
+    std::vector<uint64_t> blocks;
+    uInt n(*this);
+    while (!n.bits.empty())
+        blocks.emplace_back(n.div_and_mod_word(DECIMAL_BLOCK));
+    return blocks;
+}
+
+void uInt::remove_lead_zeros() {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(REMOVE_LEAD_ZEROS_TIME, this->bits.size())
+    #endif
+    #ifdef WORD_ACCESS
+        // Skip zero words from the top and cut at the highest set bit.
+        uint64_t i = (this->bits.size() + 63) >> 6;
+        while (i != 0 && masked_word(this->bits, i - 1) == 0)
+            --i;
+        this->bits.resize(i == 0 ? 0
+            : (i << 6) - __builtin_clzll(masked_word(this->bits, i - 1)));
+    #else
+        while (this->bits.size() != 0 && !this->bits.back())
+            this->bits.pop_back();
+    #endif
+}
+
+// Decodes digits in base 2^digit_bits by writing each digit's bits straight
+// into place, so parsing is a single linear pass with one allocation.
+void uInt::convert_power_of_two_string(const std::string& str,
+        const uint64_t& digit_bits) {
+    uint64_t base = uint64_t(1) << digit_bits, bit = 0;
+    this->bits.assign(str.size() * digit_bits, false);
+    for (auto it = str.rbegin(); it != str.rend(); ++it) {
+        uint64_t digit = digit_value(*it, base);
+        if (digit == negative_one) {
+            this->bits.clear();
+            throw std::runtime_error("ERROR: Cannot input non-base-" + std::to_string(base) + " digits");
+        }
+        for (uint64_t b = 0; b < digit_bits; ++b)
+            this->bits[bit++] = (digit >> b) & 1;
+    }
+}
+
+// Horner's rule over blocks of as many digits as fit in a word, so each block
+// costs one word sized multiply and add.
+void uInt::convert_radix_string(const std::string& str, const uint64_t& base) {
+    uInt scaled;
+    uint64_t block = 0, power = 1;
+    this->bits.clear();
+    for (auto it = str.begin(); it != str.end(); ++it) {
+        uint64_t digit = digit_value(*it, base);
+        if (digit == negative_one) {
+            this->bits.clear();
+            throw std::runtime_error("ERROR: Cannot input non-base-" + std::to_string(base) + " digits");
+        }
+        block = block * base + digit;
+        power *= base;
+        if (power > negative_one / base || it + 1 == str.end()) {
+            scaled = power;
+            scaled *= *this;
+            scaled += block;
+            this->bits.swap(scaled.bits);
+            block = 0;
+            power = 1;
+        }
+    }
+}
+
+// Returns digit d of the value written in base 2^digit_bits.
+uint64_t uInt::power_of_two_digit(const uint64_t& d, const uint64_t& digit_bits) const {
+    uint64_t value = 0, end = this->bits.size();
+    for (uint64_t bit = d * digit_bits + digit_bits - 1; bit != d * digit_bits - 1; --bit)
+        value = (value << 1) | (bit < end && this->bits[bit]);
+    return value;
+}
+
+bool uInt::odd(char c) const {
+    return c == '1' || c == '3' || c == '5' || c == '7' || c == '9';
+}
+
+std::string uInt::div_by_2(std::string str) const {
+    std::string result;
+    uint8_t add = 0, new_digit;
+    for (auto it = str.begin(); it != str.end(); ++it) {
+        if ('0' > *it || *it > '9') {
+            throw std::runtime_error("ERROR: Cannot input non-decimal digits");
+        }
+        new_digit = (int(*it) - int('0')) / 2 + add;
+        result = result + char(new_digit + int('0'));
+        add = 5 * odd(*it);
+    }
+    if (result != std::string("0") && result[0] == '0') {
+        result = result.substr(1, result.size() - 1);
+    }
+    return result;
+}
+
+// https://stackoverflow.com/questions/11006844/convert-a-very-large-number-from-decimal-string-to-binary-representation
+void uInt::convert_decimal_string(std::string str) {
+    while (str != std::string("0") && str[0] == '0') {
+        str = str.substr(1, str.size() - 1);
+    }
+    if (str == std::string("0")) {
+        this->bits.clear();
+        return;
+    }
+    while (str != std::string("0")) {
+        this->bits.emplace_back(odd(*(str.rbegin())));
+        str = div_by_2(str);
+    }
+}
+
+// https://en.wikipedia.org/wiki/Karatsuba_algorithm#Pseudocode
+// The halves are views into the operands, so only the two sums of halves and
+// the partial products are allocated at each level.
+uInt uInt::karatsuba(const uInt_view& a, const uInt_view& b) {
+    if (a.bit_length() < KARATSUBA_BOUNDARY || b.bit_length() < KARATSUBA_BOUNDARY) {
+        uInt product(a);
+        product *= b;
+        return product;
+    }
+    uint64_t m = a.bit_length() < b.bit_length() ? a.bit_length() : b.bit_length();
+    uint64_t m2 = m >> 1;
+    uInt_view l1 = a.low_bits(m2), h1 = a.window(m2, a.bit_length() - m2);
+    uInt_view l2 = b.low_bits(m2), h2 = b.window(m2, b.bit_length() - m2);
+    uInt z0 = karatsuba(l1, l2), z2 = karatsuba(h1, h2);
+    uInt s1(l1), s2(l2);
+    s1 += h1;
+    s2 += h2;
+    uInt z1 = karatsuba(s1, s2);
+    z1 -= z2;
+    z1 -= z0;
+    z2 <<= m2 << 1;
+    z1 <<= m2;
+    z2 += z1;
+    z2 += z0;
+    return z2;
+}
+
+// ============================== Public Methods ==============================
+
+// =============================== Constructors ===============================
+
+uInt::uInt() : bits(bit_vector()) {}
+
+uInt::uInt(const uint64_t& num)
+        : bits(bit_vector()) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(INT_TO_UINT_TIME, 64)
+    #endif
+    uint64_t copy = num;
+    while (copy != 0) {
+        this->bits.emplace_back(copy & 1 ? true : false);
+        copy >>= 1;
+    }
+    this->remove_lead_zeros();
+}
+
+uInt::uInt(const std::string& str)
+        : bits(bit_vector()) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(STRING_TO_UINT_TIME, str.size() << 3)
+    #endif
+    if (str.size() == 0) {
+        this->bits.clear();
+        return;
+    }
+    if (str.size() < 3) { // Decimal
+        this->convert_decimal_string(str);
+        this->remove_lead_zeros();
+        return;
+    }
+    std::string base = str.substr(0, 2);
+    if (base == std::string("0x") || base == std::string("0X")) {
+        this->convert_power_of_two_string(str.substr(2, str.size() - 2), 4);
+    } else if (base == std::string("0b") || base == std::string("0B")) {
+        this->convert_power_of_two_string(str.substr(2, str.size() - 2), 1);
+    } else {
+        this->convert_decimal_string(str);
+    }
+    this->remove_lead_zeros();
+}
+
+// Parses digits in any base from 2 to 36, or base 64 using base64_index,
+// without a prefix. Power of two bases are decoded directly into the bits.
+uInt::uInt(const std::string& str, const uint64_t& base)
+        : bits(bit_vector()) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(STRING_TO_UINT_TIME, str.size() << 3)
+    #endif
+    if (base < 2 || (base > 36 && base != 64)) {
+        throw std::runtime_error("ERROR: Unaccepted base: " + std::to_string(base));
+    }
+    if ((base & (base - 1)) == 0) {
+        this->convert_power_of_two_string(str, __builtin_ctzll(base));
+    } else if (base == 10u && !str.empty()) {
+        this->convert_decimal_string(str);
+    } else {
+        this->convert_radix_string(str, base);
+    }
+    this->remove_lead_zeros();
+}
+
+uInt::uInt(const uInt& n)
+        : bits(bit_vector()) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(COPY_TIME, n.bits.size())
+    #endif
+    if (this != &n)
+        this->bits = n.bits; // copies whole words
+}
+
+// Copies the bits a view looks at.
+uInt::uInt(const uInt_view& n)
+        : bits(bit_vector()) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(COPY_TIME, n.bit_length())
+    #endif
+    this->bits.resize(n.bit_length(), false);
+    #ifdef WORD_ACCESS
+        uint64_t* words = bit_words(this->bits);
+        for (uint64_t i = 0; i < (this->bits.size() + 63) >> 6; ++i)
+            words[i] = n.word(i);
+    #else
+        for (uint64_t i = 0; i < this->bits.size(); ++i)
+            this->bits[i] = n.test_bit(i);
+    #endif
+}
+
+// Takes over n's storage and leaves n as 0.
+uInt::uInt(uInt&& n) noexcept
+        : bits(std::move(n.bits)) {
+    n.bits.clear();
+}
+
+// ================================ To String =================================
+
+std::string uInt::to_string() const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(UINT_TO_STRING_TIME, this->bits.size())
+    #endif
+    if (this->bits.empty()) return std::string("0");
+    std::vector<uint64_t> blocks = this->decimal_blocks();
+    std::string result = std::to_string(blocks.back());
+    result.reserve(result.size() + (blocks.size() - 1) * DECIMAL_BLOCK_DIGITS);
+    char buffer[DECIMAL_BLOCK_DIGITS];
+    for (auto it = blocks.rbegin() + 1; it != blocks.rend(); ++it) {
+        write_decimal_block(*it, buffer);
+        result.append(buffer, DECIMAL_BLOCK_DIGITS);
+    }
+    return result;
+}
+
+// Power of two bases are sliced straight out of the bits into a string of
+// the final size. Other bases divide by the base one word step at a time.
+std::string uInt::to_string(const uint64_t& base) const {
+    if (base < 2 || (base > 36 && base != 64)) {
+        throw std::runtime_error("ERROR: Unaccepted base: " + std::to_string(base));
+    }
+    if (this->bits.empty()) return std::string("0");
+    if (base == 10u) {
+        return this->to_string();
+    }
+    const char* symbols = base == 64u ? base64_index : base_n_index;
+    if ((base & (base - 1)) == 0) {
+        uint64_t digit_bits = __builtin_ctzll(base);
+        uint64_t digits = (this->bits.size() + digit_bits - 1) / digit_bits;
+        std::string result_str(digits, '0');
+        for (uint64_t d = 0; d < digits; ++d)
+            result_str[digits - 1 - d] = symbols[this->power_of_two_digit(d, digit_bits)];
+        return result_str;
+    }
+    std::string result_str("");
+    uInt copy(*this);
+    while (!copy.bits.empty())
+        result_str.append(1, symbols[copy.div_and_mod_word(base)]);
+    return std::string(result_str.rbegin(), result_str.rend());
+}
+
+// ================================ Assignment ================================
+
+uInt& uInt::operator=(const uInt& n) {
+    this->bits = n.bits;
+    return *this;
+}
+
+uInt& uInt::operator=(uInt&& n) noexcept {
+    if (this != &n) {
+        this->bits.swap(n.bits);
+        n.bits.clear();
+    }
+    return *this;
+}
+
+// ============================== Add and Assign ==============================
+uInt& uInt::operator+=(const uInt& n) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(ADD_TIME, this->bits.size() + n.bits.size())
+    #endif
+        bool n1 = 0, n2 = 0, carry = 0;
+        if (this->bits.size() < n.bits.size()) {
+            this->bits.resize(n.bits.size(), false);
+        }
+        uint64_t i;
+        for (i = 0; i < n.bits.size(); ++i) {
+            n1 = this->bits[i];
+            n2 = n.bits[i];
+            this->bits[i] = carry != (n1 != n.bits[i]);
+            carry = (n1 && n2) || (n1 && carry) || (n2 && carry);
+        }
+        for (; i < this->bits.size(); ++i) {
+            n1 = this->bits[i];
+            this->bits[i] = carry != n1;
+            carry = n1 && carry;
+        }
+        if (carry)
+            this->bits.emplace_back(true);
+        return *this; 
+}
+
+// ============================= Minus and Assign =============================
+uInt& uInt::operator-=(const uInt& n) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(SUB_TIME, this->bits.size() + n.bits.size())
+    #endif
+    if (this->bits.size() < n.bits.size()) {
+        this->bits.clear();
+        return *this;
+    }
+    bool n1 = 0, n2 = 0;
+    uint64_t this_end = this->bits.size(), n_end = n.bits.size(), j;
+    for (uint64_t i = 0; i < n_end; ++i) {
+        n1 = this->bits[i];
+        n2 = n.bits[i];
+        this->bits[i] = n1 != n2;
+        if (n2 && !n1) {
+            for (j = i + 1; j < this_end; ++j) {
+                this->bits[j] = !this->bits[j];
+                if (!this->bits[j]) {
+                    break;
+                }
+            }
+            if (j == this_end) {
+                this->bits.clear();
+                return *this;
+            }
+        }
+    }
+    this->remove_lead_zeros();
+    return *this;
+}
+
+// =========================== Multiply and Assign ============================
+uInt& uInt::operator*=(const uInt& n) {
+    return *this *= uInt_view(n);
+}
+
+// ============================ Divide and Assign =============================
+uInt& uInt::operator/=(const uInt& n) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(DIV_TIME, this->bits.size() + n.bits.size())
+    #endif
+    if (n == 0) {
+        throw std::runtime_error("ERROR: Divide by 0 Exception");
+    }
+    if (this->bits.size() == 0) {
+        return *this;
+    }
+    uInt curr(0);
+    for (uint64_t i = this->bits.size() - 1; i != negative_one; --i) {
+        curr <<= 1;
+        if (this->bits[i]) ++curr;
+        if (curr >= n) {
+            this->bits[i] = true;
+            curr -= n;
+        } else {
+            this->bits[i] = false;
+        }
+    }
+    this->remove_lead_zeros();
+    return *this;
+}
+
+// ============================== Mod and Assign ==============================
+uInt& uInt::operator%=(const uInt& n) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(MOD_TIME, this->bits.size() + n.bits.size())
+    #endif
+    uInt curr(0);
+    for (uint64_t i = this->bits.size() - 1; i != negative_one; --i) {
+        curr <<= 1;
+        if (this->bits[i]) ++curr;
+        if (curr >= n) {
+            curr -= n;
+        }
+    }
+    this->bits = curr.bits;
+    this->remove_lead_zeros();
+    return *this;
+}
+
+// ========================== Shift Left and Assign ===========================
+uInt& uInt::operator<<=(const uint64_t& pos) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(SL_TIME, this->bits.size())
+    #endif
+    if (this->bits.size() == 0 || pos == 0) return *this;
+    uint64_t size = this->bits.size();
+    this->bits.reserve(size + pos);
+    #ifdef WORD_ACCESS
+        // Grow once, then move whole words down from the top with a single
+        // funnel shift pass. The new low words are zero filled by resize.
+        uint64_t old_words = (size + 63) >> 6;
+        this->bits.resize(size + pos, false);
+        uint64_t* words = bit_words(this->bits);
+        uint64_t word_shift = pos >> 6, bit_shift = pos & 63;
+        uint64_t new_words = (size + pos + 63) >> 6;
+        if (size & 63) words[old_words - 1] &= (uint64_t(1) << (size & 63)) - 1;
+        for (uint64_t i = new_words - 1; i != word_shift - 1; --i) {
+            uint64_t high = i - word_shift < old_words ? words[i - word_shift] : 0;
+            uint64_t low = i > word_shift ? words[i - word_shift - 1] : 0;
+            words[i] = bit_shift == 0
+                ? high : (high << bit_shift) | (low >> (64 - bit_shift));
+        }
+        for (uint64_t i = 0; i < word_shift; ++i)
+            words[i] = 0;
+    #else
+        this->bits.insert(this->bits.begin(), pos, false);
+    #endif
+    return *this;
+}
+
+// ========================== Shift Right and Assign ==========================
+uInt& uInt::operator>>=(const uint64_t& pos) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(SR_TIME, this->bits.size())
+    #endif
+    if (this->bits.size() == 0 || pos == 0) return *this;
+    uint64_t size = this->bits.size();
+    if (pos >= size) {
+        this->bits.clear();
+        return *this;
+    }
+    #ifdef WORD_ACCESS
+        // Move whole words up from the bottom with a single funnel shift
+        // pass, then drop the top.
+        uint64_t old_words = (size + 63) >> 6;
+        uint64_t* words = bit_words(this->bits);
+        uint64_t word_shift = pos >> 6, bit_shift = pos & 63;
+        uint64_t new_words = (size - pos + 63) >> 6;
+        if (size & 63) words[old_words - 1] &= (uint64_t(1) << (size & 63)) - 1;
+        for (uint64_t i = 0; i < new_words; ++i) {
+            uint64_t low = words[i + word_shift];
+            uint64_t high = i + word_shift + 1 < old_words ? words[i + word_shift + 1] : 0;
+            words[i] = bit_shift == 0
+                ? low : (low >> bit_shift) | (high << (64 - bit_shift));
+        }
+        this->bits.resize(size - pos);
+    #else
+        this->bits.erase(this->bits.begin(), this->bits.begin() + pos);
+    #endif
+    return *this;
+}
+
+// ========================== Bitwise AND and Assign ==========================
+uInt& uInt::operator&=(const uInt& n) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(AND_TIME, this->bits.size() + n.bits.size())
+    #endif
+    if (this->bits.size() > n.bits.size())
+        this->bits.resize(n.bits.size(), false);
+    uint64_t end = this->bits.size();
+    for (uint64_t i = 0; i < end; ++i) {
+        this->bits[i] = this->bits[i] && n.bits[i];
+    }
+    this->remove_lead_zeros();
+    return *this;
+}
+
+// ========================== Bitwise OR and Assign ===========================
+uInt& uInt::operator|=(const uInt& n) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(OR_TIME, this->bits.size() + n.bits.size())
+    #endif
+    if (this->bits.size() < n.bits.size())
+        this->bits.resize(n.bits.size(), false);
+    uint64_t end = n.bits.size();
+    for (uint64_t i = 0; i < end; ++i) {
+        this->bits[i] = this->bits[i] || n.bits[i];
+    }
+    this->remove_lead_zeros();
+    return *this;
+}
+
+// ========================== Bitwise XOR and Assign ==========================
+uInt& uInt::operator^=(const uInt& n) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(XOR_TIME, this->bits.size() + n.bits.size())
+    #endif
+        if (this->bits.size() < n.bits.size())
+            this->bits.resize(n.bits.size(), false);
+        uint64_t end = n.bits.size();
+        for (uint64_t i = 0; i < end; ++i) {
+            this->bits[i] = this->bits[i] ^ n.bits[i];
+        }
+        this->remove_lead_zeros();
+        return *this;
+}
+
+// ======================= Word Arithmetic and Assign =========================
+
+// Adds a single word in one pass which stops as soon as the carry dies, so
+// incrementing is O(1) amortized.
+uInt& uInt::operator+=(const uint64_t& num) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(ADD_TIME, this->bits.size() + 64)
+    #endif
+    if (num == 0) return *this;
+    #ifdef WORD_ACCESS
+        uint64_t num_bits = 64 - __builtin_clzll(num);
+        if (this->bits.size() < num_bits)
+            this->bits.resize(num_bits, false);
+        uint64_t size = this->bits.size(), count = (size + 63) >> 6, top = size & 63;
+        uint64_t* words = bit_words(this->bits);
+        if (top) words[count - 1] &= (uint64_t(1) << top) - 1;
+        uint64_t carry = num;
+        for (uint64_t i = 0; i < count && carry != 0; ++i) {
+            words[i] += carry;
+            carry = words[i] < carry;
+        }
+        if (carry != 0 || (top && (words[count - 1] >> top) != 0)) {
+            if (top) words[count - 1] &= (uint64_t(1) << top) - 1;
+            this->bits.emplace_back(true);
+        }
+    #else
+        unsigned __int128 carry = num;
+        for (uint64_t i = 0; carry != 0; ++i) {
+            if (i == this->bits.size()) this->bits.emplace_back(false);
+            carry += this->bits[i];
+            this->bits[i] = carry & 1;
+            carry >>= 1;
+        }
+    #endif
+    return *this;
+}
+
+// Subtracts a single word in one pass which stops as soon as the borrow dies.
+// Like operator-=(const uInt&) the result is 0 if num is larger.
+uInt& uInt::operator-=(const uint64_t& num) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(SUB_TIME, this->bits.size() + 64)
+    #endif
+    if (num == 0) return *this;
+    if (this->bits.size() <= 64 && this->low_word() <= num) {
+        this->bits.clear();
+        return *this;
+    }
+    #ifdef WORD_ACCESS
+        uint64_t* words = bit_words(this->bits);
+        uint64_t borrow = num;
+        for (uint64_t i = 0; borrow != 0; ++i) {
+            uint64_t word = words[i];
+            words[i] = word - borrow;
+            borrow = word < borrow;
+        }
+    #else
+        uint64_t subtrahend = num;
+        bool borrow = false;
+        for (uint64_t i = 0; subtrahend != 0 || borrow; ++i, subtrahend >>= 1) {
+            int difference = int(this->bits[i]) - int(subtrahend & 1) - int(borrow);
+            this->bits[i] = difference & 1;
+            borrow = difference < 0;
+        }
+    #endif
+    this->remove_lead_zeros();
+    return *this;
+}
+
+// Multiplies by a single word in one pass, carrying a word at a time.
+uInt& uInt::operator*=(const uint64_t& num) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(MUL_TIME, this->bits.size() + 64)
+    #endif
+    if (num == 0 || this->bits.empty()) {
+        this->bits.clear();
+        return *this;
+    }
+    #ifdef WORD_ACCESS
+        uint64_t count = (this->bits.size() + 63) >> 6;
+        this->bits.resize((count + 1) << 6, false);
+        uint64_t* words = bit_words(this->bits);
+        unsigned __int128 carry = 0;
+        for (uint64_t i = 0; i < count; ++i) {
+            carry += (unsigned __int128)words[i] * num;
+            words[i] = uint64_t(carry);
+            carry >>= 64;
+        }
+        words[count] = uint64_t(carry);
+        this->remove_lead_zeros();
+    #else
+        unsigned __int128 carry = 0;
+        for (uint64_t i = 0; i < this->bits.size(); ++i) {
+            if (this->bits[i]) carry += num;
+            this->bits[i] = carry & 1;
+            carry >>= 1;
+        }
+        for (; carry != 0; carry >>= 1)
+            this->bits.emplace_back(carry & 1);
+    #endif
+    return *this;
+}
+
+uInt& uInt::operator/=(const uint64_t& num) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(DIV_TIME, this->bits.size() + 64)
+    #endif
+    if (num == 0) {
+        throw std::runtime_error("ERROR: Divide by 0 Exception");
+    }
+    this->div_and_mod_word(num);
+    return *this;
+}
+
+uInt& uInt::operator%=(const uint64_t& num) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(MOD_TIME, this->bits.size() + 64)
+    #endif
+    uint64_t mod = this->div_and_mod_word(num);
+    this->bits.clear();
+    *this += mod;
+    return *this;
+}
+
+// ======================== View Arithmetic and Assign ========================
+
+// n may be a view of this value as long as it starts at or above bit 0 of it,
+// since each word of n is read before the same word of this is written.
+uInt& uInt::operator+=(const uInt_view& n) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(ADD_TIME, this->bits.size() + n.bit_length())
+    #endif
+    uint64_t n_length = n.bit_length();
+    if (this->bits.size() < n_length)
+        this->bits.resize(n_length, false);
+    #ifdef WORD_ACCESS
+        uint64_t size = this->bits.size(), count = (size + 63) >> 6, top = size & 63;
+        uint64_t n_count = (n_length + 63) >> 6;
+        if (count == 0) return *this;
+        uint64_t* words = bit_words(this->bits);
+        if (top) words[count - 1] &= (uint64_t(1) << top) - 1;
+        unsigned __int128 carry = 0;
+        for (uint64_t i = 0; i < count && (i < n_count || carry != 0); ++i) {
+            carry += (unsigned __int128)words[i] + (i < n_count ? n.word(i) : 0);
+            words[i] = uint64_t(carry);
+            carry >>= 64;
+        }
+        if (carry != 0 || (top && (words[count - 1] >> top) != 0)) {
+            if (top) words[count - 1] &= (uint64_t(1) << top) - 1;
+            this->bits.emplace_back(true);
+        }
+    #else
+        bool carry = false;
+        uint64_t i;
+        for (i = 0; i < n_length || (carry && i < this->bits.size()); ++i) {
+            bool n1 = this->bits[i], n2 = n.test_bit(i);
+            this->bits[i] = carry != (n1 != n2);
+            carry = (n1 && n2) || (n1 && carry) || (n2 && carry);
+        }
+        if (carry)
+            this->bits.emplace_back(true);
+    #endif
+    return *this;
+}
+
+// Like operator-=(const uInt&) the result is 0 if n is larger.
+uInt& uInt::operator-=(const uInt_view& n) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(SUB_TIME, this->bits.size() + n.bit_length())
+    #endif
+    uint64_t n_length = n.bit_length();
+    if (this->bits.size() < n_length) {
+        this->bits.clear();
+        return *this;
+    }
+    #ifdef WORD_ACCESS
+        uint64_t size = this->bits.size(), count = (size + 63) >> 6, top = size & 63;
+        uint64_t n_count = (n_length + 63) >> 6;
+        if (count == 0) return *this;
+        uint64_t* words = bit_words(this->bits);
+        if (top) words[count - 1] &= (uint64_t(1) << top) - 1;
+        uint64_t borrow = 0;
+        for (uint64_t i = 0; i < count && (i < n_count || borrow != 0); ++i) {
+            uint64_t subtrahend = i < n_count ? n.word(i) : 0;
+            uint64_t difference = words[i] - subtrahend - borrow;
+            borrow = words[i] < subtrahend || (words[i] == subtrahend && borrow);
+            words[i] = difference;
+        }
+    #else
+        bool borrow = false;
+        for (uint64_t i = 0; i < this->bits.size() && (i < n_length || borrow); ++i) {
+            int difference = int(this->bits[i]) - int(n.test_bit(i)) - int(borrow);
+            this->bits[i] = difference & 1;
+            borrow = difference < 0;
+        }
+    #endif
+    if (borrow) {
+        this->bits.clear();
+        return *this;
+    }
+    this->remove_lead_zeros();
+    return *this;
+}
+
+uInt& uInt::operator*=(const uInt_view& n) {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(MUL_TIME, this->bits.size() + n.bit_length())
+    #endif
+    if (this->bits.size() >= KARATSUBA_BOUNDARY && n.bit_length() >= KARATSUBA_BOUNDARY) {
+        #ifdef PERFORMANCE_TEST
+            PERFORMANCE_TIER(KARATSUBA_TIER)
+        #endif
+        *this = karatsuba(uInt_view(*this), n);
+        return *this;
+    }
+    uInt mult, shifted_n(n);
+    uint64_t end = this->bits.size();
+    for (uint64_t i = 0; i < end; ++i) {
+        if (this->bits[i]) mult += shifted_n;
+        shifted_n <<= 1;
+    }
+    this->bits.swap(mult.bits);
+    return *this;
+}
+
+// ================================ Arithmetic ================================
+
+uInt& uInt::operator+(const uInt& n) const {
+    uInt* sum = new uInt(*this);
+    *sum += n;
+    return *sum;
+}
+
+uInt& uInt::operator-(const uInt& n) const {
+    uInt* difference = new uInt(*this);
+    *difference -= n;
+    return *difference;
+}
+
+uInt& uInt::operator*(const uInt& n) const {
+    uInt* product = new uInt(*this);
+    *product *= n;
+    return *product;
+}
+
+uInt& uInt::operator/(const uInt& n) const {
+    uInt* quotient = new uInt(*this);
+    *quotient /= n;
+    return *quotient;
+}
+
+uInt& uInt::operator%(const uInt& n) const {
+    uInt* mod = new uInt(*this);
+    *mod %= n;
+    return *mod;
+}
+
+// Reserves the shifted size before copying so the copy is the only
+// allocation, then shifts in place.
+uInt& uInt::operator<<(const uint64_t& pos) const {
+    uInt* lsh = new uInt();
+    if (this->bits.empty()) return *lsh;
+    lsh->bits.reserve(this->bits.size() + pos);
+    lsh->bits = this->bits;
+    *lsh <<= pos;
+    return *lsh;
+}
+
+// Returns early without copying when every bit is shifted out.
+uInt& uInt::operator>>(const uint64_t& pos) const {
+    uInt* rsh = new uInt();
+    if (pos >= this->bits.size()) return *rsh;
+    rsh->bits = this->bits;
+    *rsh >>= pos;
+    return *rsh;
+}
+
+uInt& uInt::operator&(const uInt& n) const {
+    uInt* and_result = new uInt(*this);
+    *and_result &= n;
+    return *and_result;
+}
+
+uInt& uInt::operator|(const uInt& n) const {
+    uInt* or_result = new uInt(*this);
+    *or_result |= n;
+    return *or_result;
+}
+
+uInt& uInt::operator^(const uInt& n) const {
+    uInt* xor_result = new uInt(*this);
+    *xor_result ^= n;
+    return *xor_result;
+}
+
+uInt uInt::operator+(const uint64_t& num) const {
+    uInt sum = *this;
+    sum += num;
+    return sum;
+}
+
+uInt uInt::operator-(const uint64_t& num) const {
+    uInt difference = *this;
+    difference -= num;
+    return difference;
+}
+
+uInt uInt::operator*(const uint64_t& num) const {
+    uInt product = *this;
+    product *= num;
+    return product;
+}
+
+uInt uInt::operator/(const uint64_t& num) const {
+    uInt quotient = *this;
+    quotient /= num;
+    return quotient;
+}
+
+uInt uInt::operator%(const uint64_t& num) const {
+    uInt mod = *this;
+    mod %= num;
+    return mod;
+}
+
+// ================================ Unary =================================
+
+uInt& uInt::operator++() {
+    return *this += uint64_t(1);
+}
+
+uInt& uInt::operator--() {
+    return *this -= uint64_t(1);
+}
+
+// ============================= Conditional ==============================
+
+bool uInt::operator==(const uInt& n) const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(EQ_TIME, this->bits.size() + n.bits.size())
+    #endif
+    if (this->bits.size() != n.bits.size()) {
+        return false;
+    }
+    uint64_t end = this->bits.size();
+    for (uint64_t i = 0; i < end; ++i) {
+        if (this->bits[i] != n.bits[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool uInt::operator!=(const uInt& n) const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(NEQ_TIME, this->bits.size() + n.bits.size())
+    #endif
+    if (this->bits.size() != n.bits.size()) {
+        return true;
+    }
+    uint64_t end = this->bits.size();
+    for (uint64_t i = 0; i < end; ++i) {
+        if (this->bits[i] != n.bits[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool uInt::operator<(const uInt& n) const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(LT_TIME, this->bits.size() + n.bits.size())
+    #endif
+    if (this->bits.size() < n.bits.size()) {
+        return true;
+    }
+    if (this->bits.size() > n.bits.size()) {
+        return false;
+    }
+    for (uint64_t i = this->bits.size() - 1; i != negative_one; --i) {
+        if (this->bits[i] != n.bits[i]) {
+            return n.bits[i];
+        }
+    }
+    return false;
+}
+
+bool uInt::operator>(const uInt& n) const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(GT_TIME, this->bits.size() + n.bits.size())
+    #endif
+    if (this->bits.size() > n.bits.size()) {
+        return true;
+    }
+    if (this->bits.size() < n.bits.size()) {
+        return false;
+    }
+    for (uint64_t i = this->bits.size() - 1; i != negative_one; --i) {
+        if (this->bits[i] != n.bits[i]) {
+            return this->bits[i];
+        }
+    }
+    return false;
+}
+
+bool uInt::operator<=(const uInt& n) const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(LTE_TIME, this->bits.size() + n.bits.size())
+    #endif
+    if (this->bits.size() < n.bits.size()) {
+        return true;
+    }
+    if (this->bits.size() > n.bits.size()) {
+        return false;
+    }
+    for (uint64_t i = this->bits.size() - 1; i != negative_one; --i) {
+        if (this->bits[i] != n.bits[i]) {
+            return n.bits[i];
+        }
+    }
+    return true;
+}
+
+bool uInt::operator>=(const uInt& n) const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(GTE_TIME, this->bits.size() + n.bits.size())
+    #endif
+    if (this->bits.size() > n.bits.size()) {
+        return true;
+    }
+    if (this->bits.size() < n.bits.size()) {
+        return false;
+    }
+    for (uint64_t i = this->bits.size() - 1; i != negative_one; --i) {
+        if (this->bits[i] != n.bits[i]) {
+            return this->bits[i];
+        }
+    }
+    return true;
+}
+
+// Anything longer than a word is larger than num, so comparing with a word
+// only ever looks at the lowest word.
+bool uInt::operator==(const uint64_t& num) const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(EQ_TIME, this->bits.size() + 64)
+    #endif
+    return this->bits.size() <= 64 && this->low_word() == num;
+}
+
+bool uInt::operator!=(const uint64_t& num) const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(NEQ_TIME, this->bits.size() + 64)
+    #endif
+    return this->bits.size() > 64 || this->low_word() != num;
+}
+
+bool uInt::operator<(const uint64_t& num) const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(LT_TIME, this->bits.size() + 64)
+    #endif
+    return this->bits.size() <= 64 && this->low_word() < num;
+}
+
+bool uInt::operator>(const uint64_t& num) const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(GT_TIME, this->bits.size() + 64)
+    #endif
+    return this->bits.size() > 64 || this->low_word() > num;
+}
+
+bool uInt::operator<=(const uint64_t& num) const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(LTE_TIME, this->bits.size() + 64)
+    #endif
+    return this->bits.size() <= 64 && this->low_word() <= num;
+}
+
+bool uInt::operator>=(const uint64_t& num) const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(GTE_TIME, this->bits.size() + 64)
+    #endif
+    return this->bits.size() > 64 || this->low_word() >= num;
+}
+
+// ============================= Bit Queries ==============================
+
+// The bits are always trimmed to the highest set bit so this is O(1).
+uint64_t uInt::bit_length() const {
+    return this->bits.size();
+}
+
+uint64_t uInt::popcount() const {
+    uint64_t count = 0;
+    #ifdef WORD_ACCESS
+        for (uint64_t i = 0; i < (this->bits.size() + 63) >> 6; ++i)
+            count += __builtin_popcountll(masked_word(this->bits, i));
+    #else
+        for (uint64_t i = 0; i < this->bits.size(); ++i)
+            count += this->bits[i];
+    #endif
+    return count;
+}
+
+// Returns the index of the lowest set bit, or 0 for a value of 0.
+uint64_t uInt::count_trailing_zeros() const {
+    #ifdef WORD_ACCESS
+        for (uint64_t i = 0; i < (this->bits.size() + 63) >> 6; ++i) {
+            uint64_t word = masked_word(this->bits, i);
+            if (word != 0) return (i << 6) + __builtin_ctzll(word);
+        }
+    #else
+        for (uint64_t i = 0; i < this->bits.size(); ++i) {
+            if (this->bits[i]) return i;
+        }
+    #endif
+    return 0;
+}
+
+bool uInt::test_bit(const uint64_t& i) const {
+    return i < this->bits.size() && this->bits[i];
+}
+
+uInt& uInt::set_bit(const uint64_t& i) {
+    if (i >= this->bits.size())
+        this->bits.resize(i + 1, false);
+    this->bits[i] = true;
+    return *this;
+}
+
+// Only clearing the highest bit can change the length, in which case the
+// trim starts from that bit rather than rescanning the value.
+uInt& uInt::clear_bit(const uint64_t& i) {
+    if (i >= this->bits.size()) return *this;
+    this->bits[i] = false;
+    if (i + 1 == this->bits.size())
+        this->remove_lead_zeros();
+    return *this;
+}
+
+// =============================== Casting ================================
+
+uInt::operator uint64_t() const {
+    #ifdef PERFORMANCE_TEST
+        PERFORMANCE_SCOPE(UINT_TO_INT_TIME, this->bits.size())
+    #endif
+    uint64_t result = std::accumulate(this->bits.rbegin(), this->bits.rend(), 0ull, [](uint64_t x, bool y) { return (x << 1) + y; });
+    return result;
+}
+
+// ================================ uInt_view =================================
+
+// Reads bit i of the source.
+bool uInt_view::source_bit(const uint64_t& i) const {
+    if (this->words != nullptr) return (this->words[i >> 6] >> (i & 63)) & 1;
+    return (*this->bits)[i];
+}
+
+// Reads word i of the source, which must hold at least one bit of it.
+uint64_t uInt_view::source_word(const uint64_t& i) const {
+    if (this->words != nullptr) return this->words[i];
+    #ifdef WORD_ACCESS
+        return bit_words(*this->bits)[i];
+    #else
+        uint64_t word = 0, end = this->source_length - (i << 6);
+        end = end < 64 ? end : 64;
+        for (uint64_t b = end - 1; b != negative_one; --b)
+            word = (word << 1) | (*this->bits)[(i << 6) + b];
+        return word;
+    #endif
+}
+
+// Drops the zero bits at the top of the window.
+void uInt_view::trim() {
+    uint64_t i = (this->length + 63) >> 6;
+    while (i != 0 && this->word(i - 1) == 0)
+        --i;
+    this->length = i == 0 ? 0 : (i << 6) - __builtin_clzll(this->word(i - 1));
+}
+
+uInt_view::uInt_view()
+        : bits(nullptr), words(nullptr), source_length(0), offset(0), length(0) {}
+
+uInt_view::uInt_view(const uInt& n)
+        : bits(&n.bits), words(nullptr), source_length(n.bits.size()), offset(0),
+        length(n.bits.size()) {}
+
+// A view of bits [offset, offset + length) of n, clipped to n's length.
+uInt_view::uInt_view(const uInt& n, const uint64_t& offset, const uint64_t& length)
+        : uInt_view(n) {
+    *this = this->window(offset, length);
+}
+
+// A view of count words, least significant first, such as the words of an
+// atn::mapped_uInt.
+uInt_view::uInt_view(const uint64_t* data, const uint64_t& count)
+        : bits(nullptr), words(data), source_length(count << 6), offset(0),
+        length(count << 6) {
+    this->trim();
+}
+
+// ================================= Slices ===================================
+
+// The lowest k bits.
+uInt_view uInt_view::low_bits(const uint64_t& k) const {
+    return this->window(0, k);
+}
+
+// The highest k words, counting from the bottom word of the view, so
+// high_words(k) is the view shifted right by 64 times all the other words.
+uInt_view uInt_view::high_words(const uint64_t& k) const {
+    uint64_t count = (this->length + 63) >> 6;
+    uint64_t start = count > k ? (count - k) << 6 : 0;
+    return this->window(start, this->length - start);
+}
+
+// The len bits starting at bit start, clipped to the view.
+uInt_view uInt_view::window(const uint64_t& start, const uint64_t& len) const {
+    uInt_view slice(*this);
+    if (start >= this->length) {
+        slice.length = 0;
+        return slice;
+    }
+    slice.offset = this->offset + start;
+    slice.length = len < this->length - start ? len : this->length - start;
+    slice.trim();
+    return slice;
+}
+
+// ================================ To String =================================
+
+std::string uInt_view::to_string() const {
+    return uInt(*this).to_string();
+}
+
+std::string uInt_view::to_string(const uint64_t& base) const {
+    return uInt(*this).to_string(base);
+}
+
+// =============================== Bit Queries ================================
+
+uint64_t uInt_view::bit_length() const {
+    return this->length;
+}
+
+uint64_t uInt_view::popcount() const {
+    uint64_t count = 0;
+    for (uint64_t i = 0; i < (this->length + 63) >> 6; ++i)
+        count += __builtin_popcountll(this->word(i));
+    return count;
+}
+
+// Returns the index of the lowest set bit, or 0 for a value of 0.
+uint64_t uInt_view::count_trailing_zeros() const {
+    for (uint64_t i = 0; i < (this->length + 63) >> 6; ++i) {
+        uint64_t word = this->word(i);
+        if (word != 0) return (i << 6) + __builtin_ctzll(word);
+    }
+    return 0;
+}
+
+bool uInt_view::test_bit(const uint64_t& i) const {
+    return i < this->length && this->source_bit(this->offset + i);
+}
+
+// Returns bits [64i, 64i + 64) of the view with the bits past its length
+// cleared, built from at most two words of the source.
+uint64_t uInt_view::word(const uint64_t& i) const {
+    if (i << 6 >= this->length) return 0;
+    uint64_t start = this->offset + (i << 6), shift = start & 63;
+    uint64_t word = this->source_word(start >> 6) >> shift;
+    if (shift != 0 && (start >> 6) + 1 < (this->source_length + 63) >> 6)
+        word |= this->source_word((start >> 6) + 1) << (64 - shift);
+    uint64_t remaining = this->length - (i << 6);
+    if (remaining < 64) word &= (uint64_t(1) << remaining) - 1;
+    return word;
+}
+
+// Views compare by value, one word at a time from the top. A uInt converts to
+// a view of itself, so these also compare views with uInt values.
+
+int compare(const uInt_view& a, const uInt_view& b) {
+    if (a.bit_length() != b.bit_length()) return a.bit_length() < b.bit_length() ? -1 : 1;
+    for (uint64_t i = ((a.bit_length() + 63) >> 6) - 1; i != negative_one; --i) {
+        uint64_t x = a.word(i), y = b.word(i);
+        if (x != y) return x < y ? -1 : 1;
+    }
+    return 0;
+}
+
+bool operator==(const uInt_view& a, const uInt_view& b) {
+    return compare(a, b) == 0;
+}
+
+bool operator!=(const uInt_view& a, const uInt_view& b) {
+    return compare(a, b) != 0;
+}
+
+bool operator<(const uInt_view& a, const uInt_view& b) {
+    return compare(a, b) < 0;
+}
+
+bool operator>(const uInt_view& a, const uInt_view& b) {
+    return compare(a, b) > 0;
+}
+
+bool operator<=(const uInt_view& a, const uInt_view& b) {
+    return compare(a, b) <= 0;
+}
+
+bool operator>=(const uInt_view& a, const uInt_view& b) {
+    return compare(a, b) >= 0;
+}
+
+// =========================== Non-Class Functions ============================
+
+// =============================== Streams ================================
+
+#define STREAM_BUFFER_SIZE 256
+
+namespace { // File local helpers
+
+void write_padding(std::ostream& out, uint64_t count) {
+    for (; count != 0; --count)
+        out.put(out.fill());
+}
+
+} // End anonymous namespace
+
+// Writes n in the base selected by the stream's basefield flags (decimal by
+// default) and honours showbase, uppercase, width and adjustfield. Digits are
+// emitted through a fixed size buffer rather than built into one string:
+// hexadecimal and octal digits are sliced straight out of the bits from the
+// top down, and decimal output is written one base 10^19 block at a time.
+std::ostream& operator<<(std::ostream& out, const uInt& n) {
+    std::ios_base::fmtflags flags = out.flags();
+    std::ios_base::fmtflags base = flags & std::ios_base::basefield;
+    bool upper = flags & std::ios_base::uppercase;
+    uint64_t digit_bits = base == std::ios_base::hex ? 4 : base == std::ios_base::oct ? 3 : 0;
+    std::string prefix;
+    if ((flags & std::ios_base::showbase) && !n.bits.empty()) {
+        if (digit_bits == 4) prefix = upper ? "0X" : "0x";
+        else if (digit_bits == 3) prefix = "0";
+    }
+    std::vector<uint64_t> blocks;
+    std::string top;
+    uint64_t digits;
+    if (digit_bits != 0) {
+        digits = n.bits.empty() ? 1 : (n.bits.size() + digit_bits - 1) / digit_bits;
+    } else {
+        if (!n.bits.empty()) blocks = n.decimal_blocks();
+        top = std::to_string(blocks.empty() ? 0 : blocks.back());
+        digits = top.size() + (blocks.empty() ? 0 : blocks.size() - 1) * DECIMAL_BLOCK_DIGITS;
+    }
+    uint64_t width = out.width() > 0 ? out.width() : 0, length = prefix.size() + digits;
+    uint64_t padding = width > length ? width - length : 0;
+    std::ios_base::fmtflags adjust = flags & std::ios_base::adjustfield;
+    out.width(0);
+    if (adjust != std::ios_base::left && adjust != std::ios_base::internal)
+        write_padding(out, padding);
+    out << prefix;
+    if (adjust == std::ios_base::internal)
+        write_padding(out, padding);
+    char buffer[STREAM_BUFFER_SIZE];
+    if (digit_bits != 0) {
+        const char* symbols = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+        uint64_t used = 0;
+        for (uint64_t d = digits - 1; d != negative_one; --d) {
+            buffer[used++] = symbols[n.power_of_two_digit(d, digit_bits)];
+            if (used == STREAM_BUFFER_SIZE) {
+                out.write(buffer, used);
+                used = 0;
+            }
+        }
+        out.write(buffer, used);
+    } else {
+        out.write(top.data(), top.size());
+        for (auto it = blocks.rbegin() + (blocks.empty() ? 0 : 1); it != blocks.rend(); ++it) {
+            write_decimal_block(*it, buffer);
+            out.write(buffer, DECIMAL_BLOCK_DIGITS);
+        }
+    }
+    if (adjust == std::ios_base::left)
+        write_padding(out, padding);
+    return out;
+}
+
+namespace { // File local helpers
+
+// Fills chunk with up to STREAM_BUFFER_SIZE digits of the given radix from
+// the stream buffer, leaving the first character which is not a digit in the
+// stream, and returns the number of digits read. Sets eofbit on in if the
+// input runs out. The digits are taken through the stream buffer rather than
+// with sgetn so that the character after the number is never consumed.
+uint64_t read_digit_chunk(std::istream& in, const uint64_t& radix, uint8_t* chunk) {
+    std::streambuf* buffer = in.rdbuf();
+    uint64_t used = 0;
+    for (std::istream::int_type c = buffer->sgetc(); used < STREAM_BUFFER_SIZE; c = buffer->snextc()) {
+        if (c == std::istream::traits_type::eof()) {
+            in.setstate(std::ios_base::eofbit);
+            break;
+        }
+        uint64_t digit = digit_value(char(c), radix);
+        if (digit == negative_one) break;
+        chunk[used++] = uint8_t(digit);
+    }
+    return used;
+}
+
+} // End anonymous namespace
+
+// Reads an unsigned integer in the base selected by the stream's basefield
+// flags, accepting an optional 0x prefix in hexadecimal. The input is taken
+// STREAM_BUFFER_SIZE digits at a time. Each chunk of decimal digits is folded
+// in 19 digits at a time with an in place word multiply and add, and
+// hexadecimal and octal digits are packed into as many whole limbs as they
+// fill, so the input is never buffered as a string. Sets failbit and n to 0
+// if no digits are read.
+std::istream& operator>>(std::istream& in, uInt& n) {
+    std::istream::sentry sentry(in);
+    if (!sentry) return in;
+    std::ios_base::fmtflags base = in.flags() & std::ios_base::basefield;
+    uint64_t digit_bits = base == std::ios_base::hex ? 4 : base == std::ios_base::oct ? 3 : 0;
+    uint64_t radix = digit_bits == 0 ? 10 : uint64_t(1) << digit_bits;
+    uint64_t group_digits = digit_bits == 0 ? DECIMAL_BLOCK_DIGITS : 64 / digit_bits;
+    uInt result;
+    std::vector<uint64_t> groups; // most significant first, all full but the last
+    uint64_t group = 0, power = 1, filled = 0, total_digits = 0;
+    uint8_t chunk[STREAM_BUFFER_SIZE];
+    bool zero_prefix = false;
+    if (digit_bits == 4 && in.rdbuf()->sgetc() == '0') {
+        std::istream::int_type c = in.rdbuf()->snextc();
+        zero_prefix = true;
+        if (c == 'x' || c == 'X') {
+            in.rdbuf()->sbumpc();
+            zero_prefix = false;
+        } else if (c == std::istream::traits_type::eof()) {
+            in.setstate(std::ios_base::eofbit);
+        }
+    }
+    for (uint64_t used = STREAM_BUFFER_SIZE; used == STREAM_BUFFER_SIZE; ) {
+        used = read_digit_chunk(in, radix, chunk);
+        total_digits += used;
+        for (uint64_t i = 0; i < used; ++i) {
+            if (digit_bits != 0) {
+                group = (group << digit_bits) | chunk[i];
+            } else {
+                group = group * 10 + chunk[i];
+                power *= 10;
+            }
+            if (++filled != group_digits) continue;
+            if (digit_bits != 0) {
+                groups.emplace_back(group);
+            } else {
+                result *= DECIMAL_BLOCK;
+                result += group;
+                power = 1;
+            }
+            group = 0;
+            filled = 0;
+        }
+    }
+    if (total_digits == 0 && !zero_prefix) {
+        n.bits.clear();
+        in.setstate(std::ios_base::failbit);
+        return in;
+    }
+    if (digit_bits != 0) {
+        // The last group holds filled digits and every other group holds
+        // group_digits, so each group's place is known once all are read.
+        if (filled != 0) groups.emplace_back(group);
+        uint64_t group_bits = group_digits * digit_bits;
+        uint64_t position = filled * digit_bits + (groups.size() - (filled != 0 ? 1 : 0)) * group_bits;
+        std::vector<uint64_t> limbs((position + 63) >> 6, 0);
+        for (uint64_t j = 0; j < groups.size(); ++j) {
+            position -= j + 1 == groups.size() && filled != 0 ? filled * digit_bits : group_bits;
+            uint64_t shift = position & 63;
+            limbs[position >> 6] |= groups[j] << shift;
+            if (shift != 0 && (position >> 6) + 1 < limbs.size())
+                limbs[(position >> 6) + 1] |= groups[j] >> (64 - shift);
+        }
+        result = from_words(limbs);
+    } else if (filled != 0) {
+        result *= power;
+        result += group;
+    }
+    n = std::move(result);
+    return in;
+}
+
+uInt operator+(const uint64_t& num, const uInt& n) {
+    return n + num;
+}
+
+// The result of -, / and % with a word on the left fits in a word, so n is
+// only converted when it fits in one too.
+uInt operator-(const uint64_t& num, const uInt& n) {
+    uInt difference;
+    if (n < num) difference += num - uint64_t(n);
+    return difference;
+}
+
+uInt operator*(const uint64_t& num, const uInt& n) {
+    return n * num;
+}
+
+uInt operator/(const uint64_t& num, const uInt& n) {
+    if (n.bits.empty()) {
+        throw std::runtime_error("ERROR: Divide by 0 Exception");
+    }
+    uInt quotient;
+    if (n <= num) quotient += num / uint64_t(n);
+    return quotient;
+}
+
+uInt operator%(const uint64_t& num, const uInt& n) {
+    if (n.bits.empty()) {
+        throw std::runtime_error("ERROR: Divide/Mod by 0 Exception");
+    }
+    uInt mod;
+    mod += n <= num ? num % uint64_t(n) : num;
+    return mod;
+}
+
+uInt& operator&(const uint64_t& num, const uInt& n) {
+    return n & num;
+}
+
+uInt& operator|(const uint64_t& num, const uInt& n) {
+    return n | num;
+}
+
+uInt& operator^(const uint64_t& num, const uInt& n) {
+    return n ^ num;
+}
+
+// =========================== Binary Import/Export ===========================
+
+namespace { // File local helpers
+
+// The word order, byte order and nail conventions all follow GMP's
+// mpz_import and mpz_export. order is 1 when the most significant word comes
+// first and -1 when the least significant word comes first. endian is 1 for
+// big endian bytes within a word, -1 for little endian and 0 for the host's
+// byte order. The top nails bits of every word are unused.
+void validate_binary_format(const int& order, const uint64_t& size,
+        const int& endian, const uint64_t& nails) {
+    if (order != 1 && order != -1) {
+        throw std::runtime_error("ERROR: Word order must be 1 or -1");
+    }
+    if (endian != 1 && endian != 0 && endian != -1) {
+        throw std::runtime_error("ERROR: Endianness must be 1, 0 or -1");
+    }
+    if (size == 0 || nails >= size * CHAR_BIT) {
+        throw std::runtime_error("ERROR: Words must have at least one non-nail bit");
+    }
+}
+
+int native_endian() {
+    #if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return 1;
+    #else
+        return -1;
+    #endif
+}
+
+// Reads up to eight bytes of a word of size bytes, starting with the byte of
+// significance first, as one value. Little endian words on a little endian
+// host are copied as they are.
+uint64_t read_word_bytes(const uint8_t* word, const uint64_t& size,
+        const int& byte_order, const uint64_t& first) {
+    uint64_t value = 0, bytes = size - first < 8 ? size - first : 8;
+    if (byte_order == -1 && native_endian() == -1) {
+        std::memcpy(&value, word + first, bytes);
+        return value;
+    }
+    for (uint64_t b = 0; b < bytes; ++b) {
+        uint64_t j = first + b;
+        value |= uint64_t(word[byte_order == -1 ? j : size - 1 - j]) << (b << 3);
+    }
+    return value;
+}
+
+// The inverse of read_word_bytes.
+void write_word_bytes(uint8_t* word, const uint64_t& size, const int& byte_order,
+        const uint64_t& first, const uint64_t& value) {
+    uint64_t bytes = size - first < 8 ? size - first : 8;
+    if (byte_order == -1 && native_endian() == -1) {
+        std::memcpy(word + first, &value, bytes);
+        return;
+    }
+    for (uint64_t b = 0; b < bytes; ++b) {
+        uint64_t j = first + b;
+        word[byte_order == -1 ? j : size - 1 - j] = uint8_t(value >> (b << 3));
+    }
+}
+
+uint64_t low_bits_mask(const uint64_t& length) {
+    return length >= 64 ? negative_one : (uint64_t(1) << length) - 1;
+}
+
+} // End anonymous namespace
+
+// Sets n to the value held in count words of size bytes at op. n is sized
+// once and each word is read up to 64 bits at a time and shifted straight
+// into place among n's limbs, mirroring export_bits.
+void import_bits(uInt& n, const uint64_t& count, const int& order,
+        const uint64_t& size, const int& endian, const uint64_t& nails,
+        const void* op) {
+    validate_binary_format(order, size, endian, nails);
+    int byte_order = endian == 0 ? native_endian() : endian;
+    const uint8_t* data = static_cast<const uint8_t*>(op);
+    uint64_t word_bits = size * CHAR_BIT - nails;
+    n.bits.assign(count * word_bits, false);
+    #ifdef WORD_ACCESS
+        uint64_t* limbs = bit_words(n.bits);
+        uint64_t limb_count = (n.bits.size() + 63) >> 6;
+    #endif
+    for (uint64_t k = 0; k < count; ++k) {
+        const uint8_t* word = data + (order == -1 ? k : count - 1 - k) * size;
+        for (uint64_t chunk = 0; chunk < word_bits; chunk += 64) {
+            uint64_t position = k * word_bits + chunk;
+            uint64_t value = read_word_bytes(word, size, byte_order, chunk >> 3)
+                & low_bits_mask(word_bits - chunk);
+            #ifdef WORD_ACCESS
+                uint64_t i = position >> 6, shift = position & 63;
+                limbs[i] |= value << shift;
+                if (shift != 0 && i + 1 < limb_count)
+                    limbs[i + 1] |= value >> (64 - shift);
+            #else
+                for (; value != 0; value &= value - 1)
+                    n.bits[position + __builtin_ctzll(value)] = true;
+            #endif
+        }
+    }
+    n.remove_lead_zeros();
+}
+
+// Returns the number of words of size bytes needed to export n.
+uint64_t export_count(const uInt& n, const uint64_t& size, const uint64_t& nails) {
+    validate_binary_format(1, size, 0, nails);
+    uint64_t word_bits = size * CHAR_BIT - nails;
+    return (n.bits.size() + word_bits - 1) / word_bits;
+}
+
+// Writes n into rop, which must have room for export_count(n, size, nails)
+// words, and returns the number of words written. Nail bits are zeroed. Each
+// word is cut out of n's limbs up to 64 bits at a time.
+uint64_t export_bits(void* rop, const int& order, const uint64_t& size,
+        const int& endian, const uint64_t& nails, const uInt& n) {
+    validate_binary_format(order, size, endian, nails);
+    int byte_order = endian == 0 ? native_endian() : endian;
+    uint8_t* data = static_cast<uint8_t*>(rop);
+    uint64_t word_bits = size * CHAR_BIT - nails;
+    uint64_t count = (n.bits.size() + word_bits - 1) / word_bits;
+    std::vector<uint64_t> limbs = to_words(n);
+    for (uint64_t k = 0; k < count; ++k) {
+        uint8_t* word = data + (order == -1 ? k : count - 1 - k) * size;
+        for (uint64_t chunk = 0; chunk < size * CHAR_BIT; chunk += 64) {
+            uint64_t value = 0;
+            if (chunk < word_bits) {
+                uint64_t position = k * word_bits + chunk, shift = position & 63;
+                uint64_t i = position >> 6;
+                if (i < limbs.size()) value = limbs[i] >> shift;
+                if (shift != 0 && i + 1 < limbs.size()) value |= limbs[i + 1] << (64 - shift);
+                value &= low_bits_mask(word_bits - chunk);
+            }
+            write_word_bytes(word, size, byte_order, chunk >> 3, value);
+        }
+    }
+    return count;
+}
+
+// ============================== Combinatorics ===============================
+
+// Returns all of the primes less than or equal to n in increasing order using
+// a sieve of Eratosthenes over the odd numbers.
+std::vector<uint64_t> primes_up_to(const uint64_t& n) {
+    std::vector<uint64_t> primes;
+    if (n < 2) return primes;
+    primes.emplace_back(2);
+    std::vector<bool> composite((n + 1) >> 1, false); // i represents 2i + 1
+    for (uint64_t i = 1; i < composite.size(); ++i) {
+        if (composite[i]) continue;
+        uint64_t p = (i << 1) + 1;
+        primes.emplace_back(p);
+        if (p > n / p) continue;
+        for (uint64_t j = (p * p) >> 1; j < composite.size(); j += p)
+            composite[j] = true;
+    }
+    return primes;
+}
+
+namespace { // File local helpers
+
+// Multiplies a list of machine words. Neighbouring words are combined
+// natively for as long as their product fits in a single word, then the
+// remaining leaves are multiplied with a balanced product tree.
+std::vector<uint64_t> product_of_words(const std::vector<uint64_t>& words) {
+    std::vector<std::vector<uint64_t>> leaves;
+    uint64_t leaf = 1, next;
+    for (auto it = words.begin(); it != words.end(); ++it) {
+        if (*it == 0) return std::vector<uint64_t>();
+        if (__builtin_mul_overflow(leaf, *it, &next)) {
+            leaves.emplace_back(1, leaf);
+            leaf = *it;
+        } else {
+            leaf = next;
+        }
+    }
+    leaves.emplace_back(1, leaf);
+    return words_product(leaves);
+}
+
+// Computes the prime swing of n, n! / ((n / 2)!)^2, from its factorization.
+// The exponent of a prime p is the number of odd values in the sequence
+// n / p, n / p^2, ... and every prime power in the result is at most n so it
+// fits in a single word.
+std::vector<uint64_t> prime_swing(const uint64_t& n, const std::vector<uint64_t>& primes) {
+    std::vector<uint64_t> factors;
+    for (auto it = primes.begin(); it != primes.end() && *it <= n; ++it) {
+        uint64_t q = n, power = 1;
+        while ((q /= *it) != 0) {
+            if (q & 1) power *= *it;
+        }
+        if (power != 1) factors.emplace_back(power);
+    }
+    return product_of_words(factors);
+}
+
+} // End anonymous namespace
+
+// Peter Luschny's prime swing factorial. Uses n! = ((n / 2)!)^2 * swing(n) so
+// the work is a handful of squarings plus the balanced products of each swing,
+// all on words with a single conversion at the end.
+uInt factorial(const uint64_t& n) {
+    std::vector<uint64_t> chain;
+    uint64_t m = n;
+    for (; m > 20; m >>= 1)
+        chain.emplace_back(m);
+    uint64_t small = 1;
+    for (uint64_t i = 2; i <= m; ++i)
+        small *= i;
+    std::vector<uint64_t> result(1, small), square;
+    if (chain.empty()) return from_words(result);
+    std::vector<uint64_t> primes = primes_up_to(n);
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        words_sqr(result, square);
+        result = words_mul(square, prime_swing(*it, primes));
+    }
+    return from_words(result);
+}
+
+// Computes n choose k from its prime factorization. By Kummer's theorem the
+// exponent of a prime p is the number of borrows when subtracting k from n in
+// base p, and every prime power in the result is at most n.
+uInt binomial(const uint64_t& n, uint64_t k) {
+    if (k > n) return ZERO;
+    if (k > n - k) k = n - k;
+    if (k == 0) return ONE;
+    std::vector<uint64_t> primes = primes_up_to(n), factors;
+    for (auto it = primes.begin(); it != primes.end(); ++it) {
+        uint64_t p = *it, a = n, b = k, borrow = 0, power = 1;
+        while (a != 0) {
+            borrow = a % p < b % p + borrow;
+            if (borrow) power *= p;
+            a /= p;
+            b /= p;
+        }
+        if (power != 1) factors.emplace_back(power);
+    }
+    return from_words(product_of_words(factors));
+}
+
+// ============================ Linear Recurrences =============================
+
+namespace { // File local helpers
+
+// Fast doubling on the pair (F(k), F(k + 1)) using
+// F(2k) = F(k) * (2F(k + 1) - F(k)) and F(2k + 1) = F(k)^2 + F(k + 1)^2,
+// so each step is one multiplication and two squarings on words. All
+// temporaries are local so it is safe to call from several threads.
+void fibonacci_pair(const uint64_t& n, std::vector<uint64_t>& f0, std::vector<uint64_t>& f1) {
+    f0.clear();
+    f1.assign(1, 1);
+    std::vector<uint64_t> c, d, square;
+    for (uint64_t bit = 63; bit != negative_one; --bit) {
+        if ((n >> bit) == 0) continue;
+        c = f1;
+        words_shift_left(c, 1);
+        words_sub(c, f0);
+        c = words_mul(c, f0);
+        words_sqr(f0, d);
+        words_sqr(f1, square);
+        words_add(d, square);
+        if ((n >> bit) & 1) {
+            words_add(c, d);
+            f0.swap(d);
+            f1.swap(c);
+        } else {
+            f0.swap(c);
+            f1.swap(d);
+        }
+    }
+}
+
+} // End anonymous namespace
+
+uInt fibonacci(const uint64_t& n) {
+    std::vector<uint64_t> f0, f1;
+    fibonacci_pair(n, f0, f1);
+    return from_words(f0);
+}
+
+// Uses L(n) = 2F(n + 1) - F(n).
+uInt lucas(const uint64_t& n) {
+    std::vector<uint64_t> f0, f1;
+    fibonacci_pair(n, f0, f1);
+    words_shift_left(f1, 1);
+    words_sub(f1, f0);
+    return from_words(f1);
+}
+
+namespace { // File local helpers
+
+// Reduces a polynomial modulo the characteristic polynomial
+// x^k - c[0]x^(k - 1) - ... - c[k - 1] by repeatedly replacing the leading
+// term x^d with c[0]x^(d - 1) + ... + c[k - 1]x^(d - k). Every coefficient
+// is non-negative so the reduction never needs a subtraction, and each term
+// is multiplied and added in one pass.
+void reduce_recurrence_polynomial(std::vector<std::vector<uint64_t>>& poly,
+        const std::vector<std::vector<uint64_t>>& coefficients) {
+    uint64_t k = coefficients.size();
+    for (uint64_t d = poly.size() - 1; d >= k; --d) {
+        for (uint64_t j = 0; j < k; ++j)
+            words_add_mul(poly[d - 1 - j], poly[d], coefficients[j]);
+    }
+    poly.resize(k);
+}
+
+} // End anonymous namespace
+
+// Kitamasa's method. For a(n) = c[0]a(n - 1) + c[1]a(n - 2) + ... +
+// c[k - 1]a(n - k) with a(0), ..., a(k - 1) given by initial, computes
+// x^n modulo the characteristic polynomial by square and multiply so that
+// a(n) = r[0]a(0) + ... + r[k - 1]a(k - 1). Squaring sums each cross product
+// once, doubles the sums with one shift and adds the squares on the
+// diagonal. Everything is done on words and converted back once.
+uInt linear_recurrence(const std::vector<uInt>& coefficients,
+        const std::vector<uInt>& initial, const uint64_t& n) {
+    uint64_t k = coefficients.size();
+    if (k == 0 || initial.size() != k) {
+        throw std::runtime_error("ERROR: Recurrence needs one initial value per coefficient");
+    }
+    if (n < k) return initial[n];
+    std::vector<std::vector<uint64_t>> c(k), result(k), square((k << 1) - 1);
+    for (uint64_t i = 0; i < k; ++i)
+        c[i] = to_words(coefficients[i]);
+    result[0].assign(1, 1);
+    std::vector<uint64_t> diagonal;
+    uint64_t bit = 63;
+    while ((n >> bit) == 0) --bit;
+    for (; bit != negative_one; --bit) {
+        for (uint64_t i = 0; i < square.size(); ++i)
+            square[i].clear();
+        for (uint64_t i = 0; i < k; ++i) {
+            for (uint64_t j = i + 1; j < k; ++j)
+                words_add_mul(square[i + j], result[i], result[j]);
+        }
+        for (uint64_t i = 0; i < square.size(); ++i)
+            words_shift_left(square[i], 1);
+        for (uint64_t i = 0; i < k; ++i) {
+            words_sqr(result[i], diagonal);
+            words_add(square[i << 1], diagonal);
+        }
+        if ((n >> bit) & 1)
+            square.insert(square.begin(), std::vector<uint64_t>());
+        reduce_recurrence_polynomial(square, c);
+        for (uint64_t i = 0; i < k; ++i)
+            result[i].swap(square[i]);
+        square.resize((k << 1) - 1);
+    }
+    std::vector<uint64_t> sum;
+    for (uint64_t i = 0; i < k; ++i)
+        words_add_mul(sum, result[i], to_words(initial[i]));
+    return from_words(sum);
+}
+
+// =============================== Number Theory ==============================
+
+// Below this many words gcd uses the binary algorithm, above it Lehmer's.
+#define GCD_LEHMER_WORDS 4
+
+namespace { // File local helpers
+
+uint64_t gcd_word(uint64_t a, uint64_t b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    uint64_t shift = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    while (b != 0) {
+        b >>= __builtin_ctzll(b);
+        if (a > b) std::swap(a, b);
+        b -= a;
+    }
+    return a << shift;
+}
+
+// Stein's binary gcd. Only shifts and subtractions, which is the cheapest
+// option while the operands are a few words long.
+std::vector<uint64_t> binary_gcd_words(std::vector<uint64_t> a, std::vector<uint64_t> b) {
+    if (a.empty()) return b;
+    if (b.empty()) return a;
+    uint64_t a_zeros = words_count_trailing_zeros(a);
+    uint64_t b_zeros = words_count_trailing_zeros(b);
+    uint64_t shift = a_zeros < b_zeros ? a_zeros : b_zeros;
+    words_shift_right(a, a_zeros);
+    words_shift_right(b, b_zeros);
+    while (true) {
+        if (a.size() == 1 && b.size() == 1) {
+            a[0] = gcd_word(a[0], b[0]);
+            break;
+        }
+        int cmp = words_compare(a, b);
+        if (cmp == 0) break;
+        if (cmp > 0) a.swap(b);
+        words_sub(b, a);
+        words_shift_right(b, words_count_trailing_zeros(b));
+    }
+    words_shift_left(a, shift);
+    return a;
+}
+
+// Computes p * a - q * b, or q * b - p * a when negate is set, into result.
+// Returns false instead if the difference would be negative.
+bool words_combination(const std::vector<uint64_t>& a, const uint64_t& p,
+        const std::vector<uint64_t>& b, const uint64_t& q, const bool& negate,
+        std::vector<uint64_t>& result) {
+    std::vector<uint64_t> pa = words_mul_word(a, p), qb = words_mul_word(b, q);
+    if (negate) pa.swap(qb);
+    if (words_compare(pa, qb) < 0) return false;
+    words_sub(pa, qb);
+    result.swap(pa);
+    return true;
+}
+
+// Euclid's algorithm with Lehmer's acceleration (Knuth's Algorithm L). The
+// quotient sequence is simulated on the leading 62 bits of a and b for as long
+// as it provably matches the real one, then the resulting 2x2 matrix is
+// applied to the full values with single word multiplications. A full
+// division is only needed when the leading bits do not determine a quotient.
+// When x is given it receives the magnitude of the cofactor of the original a
+// and the return value is true when that cofactor is negative.
+bool lehmer_gcd_words(std::vector<uint64_t>& a, std::vector<uint64_t>& b,
+        std::vector<uint64_t>* x) {
+    std::vector<uint64_t> s0(1, 1), s1, q, r, t0, t1;
+    bool odd = false;
+    while (!b.empty()) {
+        uint64_t length = words_bit_length(a);
+        if (length > 64 && words_compare(a, b) >= 0) {
+            uint64_t shift = length - 62;
+            __int128 xh = words_window(a, shift), yh = words_window(b, shift);
+            __int128 A = 1, B = 0, C = 0, D = 1, T;
+            uint64_t steps = 0;
+            while (yh + C > 0 && yh + D > 0) {
+                __int128 quotient = (xh + A) / (yh + C);
+                if (quotient != (xh + B) / (yh + D)) break;
+                T = A - quotient * C; A = C; C = T;
+                T = B - quotient * D; B = D; D = T;
+                T = xh - quotient * yh; xh = yh; yh = T;
+                ++steps;
+            }
+            uint64_t a0 = uint64_t(A < 0 ? -A : A), b0 = uint64_t(B < 0 ? -B : B);
+            uint64_t c0 = uint64_t(C < 0 ? -C : C), d0 = uint64_t(D < 0 ? -D : D);
+            if (B != 0 && words_combination(a, a0, b, b0, A < 0, t0)
+                    && words_combination(a, c0, b, d0, C < 0, t1)) {
+                a.swap(t0);
+                b.swap(t1);
+                if (x != nullptr) {
+                    t0 = words_mul_word(s0, a0);
+                    words_add(t0, words_mul_word(s1, b0));
+                    t1 = words_mul_word(s0, c0);
+                    words_add(t1, words_mul_word(s1, d0));
+                    s0.swap(t0);
+                    s1.swap(t1);
+                }
+                odd ^= steps & 1;
+                continue;
+            }
+        }
+        words_div_mod(a, b, q, r);
+        a.swap(b);
+        b.swap(r);
+        if (x != nullptr) {
+            t0 = words_mul(q, s1);
+            words_add(t0, s0);
+            s0.swap(s1);
+            s1.swap(t0);
+        }
+        odd = !odd;
+    }
+    if (x != nullptr) x->swap(s0);
+    return odd;
+}
+
+} // End anonymous namespace
+
+uInt gcd(const uInt& a, const uInt& b) {
+    std::vector<uint64_t> x = to_words(a), y = to_words(b);
+    if (x.size() < GCD_LEHMER_WORDS && y.size() < GCD_LEHMER_WORDS)
+        return from_words(binary_gcd_words(x, y));
+    if (words_compare(x, y) < 0) x.swap(y);
+    lehmer_gcd_words(x, y, nullptr);
+    return from_words(x);
+}
+
+// Returns gcd(a, b) together with x and y such that a * x + b * y = gcd(a, b).
+// The cofactors are the ones produced by Euclid's algorithm, so |x| <= b / 2g
+// and |y| <= a / 2g whenever both a and b are greater than g.
+gcdext_result gcdext(const uInt& a, const uInt& b) {
+    gcdext_result result;
+    std::vector<uint64_t> x = to_words(a), y = to_words(b), s;
+    result.x_negative = lehmer_gcd_words(x, y, &s);
+    result.gcd = from_words(x);
+    result.x = from_words(s);
+    result.y_negative = false;
+    if (s.empty()) result.x_negative = false;
+    if (b.bits.empty()) return result;
+    // y = (gcd - a * x) / b, which is exact
+    std::vector<uint64_t> ax = words_mul(to_words(a), s), q, r;
+    if (result.x_negative || s.empty()) {
+        words_add(ax, x);
+    } else {
+        words_sub(ax, x);
+        result.y_negative = !ax.empty();
+    }
+    words_div_mod(ax, to_words(b), q, r);
+    result.y = from_words(q);
+    return result;
+}
+
+uInt lcm(const uInt& a, const uInt& b) {
+    if (a.bits.empty() || b.bits.empty()) return ZERO;
+    std::vector<uint64_t> q, r;
+    words_div_mod(to_words(a), to_words(gcd(a, b)), q, r);
+    return from_words(words_mul(q, to_words(b)));
+}
+
+// Returns the x in [0, m) with a * x = 1 (mod m).
+uInt invert_mod(const uInt& a, const uInt& m) {
+    if (m.bits.empty()) {
+        throw std::runtime_error("ERROR: Modulus must be non-zero");
+    }
+    std::vector<uint64_t> q, r;
+    words_div_mod(to_words(a), to_words(m), q, r);
+    gcdext_result e = gcdext(from_words(r), m);
+    if (e.gcd != ONE) {
+        throw std::runtime_error("ERROR: " + a.to_string() + " is not invertible modulo " + m.to_string());
+    }
+    if (!e.x_negative) return e.x;
+    uInt result = m;
+    result -= e.x;
+    return result;
+}
+
+namespace { // File local helpers
+
+// Returns x^k, or negative_one if that is larger than limit.
+uint64_t bounded_power(const uint64_t& x, uint64_t k, const uint64_t& limit) {
+    uint64_t result = 1;
+    while (k-- != 0) {
+        if (__builtin_mul_overflow(result, x, &result) || result > limit)
+            return negative_one;
+    }
+    return result;
+}
+
+// Integer Newton iteration for the floor of the k-th root of a word, starting
+// from a power of two which is at least the root.
+uint64_t root_word(const uint64_t& n, const uint64_t& k) {
+    uint64_t length = 64 - __builtin_clzll(n);
+    uint64_t x = uint64_t(1) << ((length + k - 1) / k), next;
+    while (true) {
+        uint64_t power = bounded_power(x, k - 1, n);
+        uint64_t quotient = power == negative_one ? 0 : n / power;
+        next = (uint64_t((unsigned __int128)(k - 1) * x / k)
+            + (((unsigned __int128)(k - 1) * x % k) + quotient) / k);
+        if (next >= x) return x;
+        x = next;
+    }
+}
+
+std::vector<uint64_t> words_power(const std::vector<uint64_t>& x, uint64_t k) {
+    std::vector<uint64_t> result(1, 1), base = x, square;
+    while (k != 0) {
+        if (k & 1) result = words_mul(result, base);
+        k >>= 1;
+        if (k != 0) {
+            words_sqr(base, square);
+            base.swap(square);
+        }
+    }
+    return result;
+}
+
+} // End anonymous namespace
+
+// Returns base^exp. The trailing zero bits of the base are pulled out first
+// and put back with a single shift at the end, so a power of two costs only
+// the shift. The odd part is raised left to right over sliding windows of up
+// to four exponent bits: one squaring per bit and one multiplication per
+// window by a precomputed odd power. The squarings alternate between two
+// buffers reserved up front for the full size of the result.
+uInt pow(const uInt& base, const uint64_t& exp) {
+    if (exp == 0) return ONE;
+    if (base.bits.empty()) return ZERO;
+    uint64_t zeros = base.count_trailing_zeros(), shift, estimate;
+    std::vector<uint64_t> x = to_words(base);
+    words_shift_right(x, zeros);
+    if (__builtin_mul_overflow(zeros, exp, &shift)
+            || __builtin_mul_overflow(words_bit_length(x), exp, &estimate)
+            || estimate + shift < estimate) {
+        throw std::runtime_error("ERROR: The power has too many bits");
+    }
+    std::vector<uint64_t> result(1, 1), square;
+    if (words_bit_length(x) > 1) {
+        uint64_t length = 64 - __builtin_clzll(exp);
+        uint64_t window = length > 16 ? 4 : length > 8 ? 3 : length > 3 ? 2 : 1;
+        std::vector<std::vector<uint64_t>> odd_powers(uint64_t(1) << (window - 1));
+        odd_powers[0] = x;
+        if (odd_powers.size() > 1) words_sqr(x, square);
+        for (uint64_t i = 1; i < odd_powers.size(); ++i)
+            odd_powers[i] = words_mul(odd_powers[i - 1], square);
+        result.reserve((estimate >> 6) + 2);
+        square.reserve((estimate >> 6) + 2);
+        bool started = false;
+        for (uint64_t i = length - 1; i != negative_one;) {
+            if (((exp >> i) & 1) == 0) {
+                words_sqr(result, square);
+                result.swap(square);
+                --i;
+                continue;
+            }
+            uint64_t low = i + 1 >= window ? i + 1 - window : 0;
+            while (((exp >> low) & 1) == 0)
+                ++low;
+            uint64_t digit = (exp >> low) & ((uint64_t(1) << (i - low + 1)) - 1);
+            for (uint64_t j = low; j <= i && started; ++j) {
+                words_sqr(result, square);
+                result.swap(square);
+            }
+            if (started) {
+                result = words_mul(result, odd_powers[digit >> 1]);
+            } else {
+                result = odd_powers[digit >> 1];
+                result.reserve((estimate >> 6) + 2);
+                started = true;
+            }
+            i = low - 1;
+        }
+    }
+    uInt power = from_words(result);
+    power <<= shift;
+    return power;
+}
+
+namespace { // File local helpers
+
+// Floor of the k-th root of n for k >= 2 and n > 0. The leading half of the
+// root's bits comes from a recursive call on the leading bits of n, so the
+// estimate already has the relative error of a half sized root. A single
+// Newton step x = ((k - 1)x + n / x^(k - 1)) / k then roughly doubles the
+// number of correct bits and, by the AM-GM inequality, lands on or above the
+// root, after which the iteration decreases monotonically to it. Each level
+// performs a couple of full size divisions and the levels halve in size.
+std::vector<uint64_t> root_words(const std::vector<uint64_t>& n, const uint64_t& k) {
+    uint64_t length = words_bit_length(n);
+    if (length <= 64) return std::vector<uint64_t>(1, root_word(n[0], k));
+    if (k >= length) return std::vector<uint64_t>(1, 1);
+    uint64_t half = ((length - 1) / k + 1) >> 1;
+    std::vector<uint64_t> x = n, divisor(1, k), q, r;
+    words_shift_right(x, k * half);
+    x = root_words(x, k);
+    words_shift_left(x, half);
+    bool first = true;
+    while (true) {
+        words_div_mod(n, words_power(x, k - 1), q, r);
+        std::vector<uint64_t> next = words_mul_word(x, k - 1);
+        words_add(next, q);
+        words_div_mod(next, divisor, q, r);
+        if (!first && words_compare(q, x) >= 0) return x;
+        x.swap(q);
+        first = false;
+    }
+}
+
+} // End anonymous namespace
+
+// Returns the floor of the k-th root of n.
+uInt iroot(const uInt& n, const uint64_t& k) {
+    if (k == 0) {
+        throw std::runtime_error("ERROR: The 0th root is undefined");
+    }
+    if (k == 1 || n.bits.empty()) return n;
+    return from_words(root_words(to_words(n), k));
+}
+
+// Returns the floor of the k-th root of n and the remainder n - root^k.
+std::pair<uInt, uInt> rootrem(const uInt& n, const uint64_t& k) {
+    uInt root = iroot(n, k), remainder = n;
+    remainder -= from_words(words_power(to_words(root), k));
+    return std::pair<uInt, uInt>(root, remainder);
+}
+
+uInt isqrt(const uInt& n) {
+    return iroot(n, 2);
+}
+
+// Returns the floor of the square root of n and the remainder n - root^2.
+std::pair<uInt, uInt> sqrtrem(const uInt& n) {
+    return rootrem(n, 2);
+}
+
+// ================================ Primality =================================
+
+// Candidates are checked for factors up to this bound before any modular
+// exponentiation is done.
+#define TRIAL_DIVISION_LIMIT 1000
+
+namespace { // File local helpers
+
+// Returns a mod w with a single pass over the words of a.
+uint64_t words_mod_word(const std::vector<uint64_t>& a, const uint64_t& w) {
+    unsigned __int128 remainder = 0;
+    for (uint64_t i = a.size() - 1; i != negative_one; --i)
+        remainder = ((remainder << 64) | a[i]) % w;
+    return uint64_t(remainder);
+}
+
+// The odd primes below TRIAL_DIVISION_LIMIT, and the same primes multiplied
+// together into groups whose products fit in a word. Trial division takes one
+// remainder per group and then reduces it by each prime natively.
+struct trial_division_table {
+    std::vector<uint64_t> primes;
+    std::vector<uint64_t> products;
+    std::vector<uint64_t> group_ends;
+    trial_division_table() {
+        std::vector<uint64_t> all = primes_up_to(TRIAL_DIVISION_LIMIT);
+        primes.assign(all.begin() + 1, all.end());
+        uint64_t product = 1, next;
+        for (uint64_t i = 0; i < primes.size(); ++i) {
+            if (__builtin_mul_overflow(product, primes[i], &next)) {
+                products.emplace_back(product);
+                group_ends.emplace_back(i);
+                next = primes[i];
+            }
+            product = next;
+        }
+        products.emplace_back(product);
+        group_ends.emplace_back(primes.size());
+    }
+};
+
+const trial_division_table& trial_division_primes() {
+    static const trial_division_table table;
+    return table;
+}
+
+// Returns the Jacobi symbol (a / m) for an odd m.
+int jacobi_word(uint64_t a, uint64_t m) {
+    int result = 1;
+    a %= m;
+    while (a != 0) {
+        uint64_t zeros = __builtin_ctzll(a);
+        a >>= zeros;
+        if ((zeros & 1) && ((m & 7) == 3 || (m & 7) == 5)) result = -result;
+        if ((a & 3) == 3 && (m & 3) == 3) result = -result;
+        std::swap(a, m);
+        a %= m;
+    }
+    return m == 1 ? result : 0;
+}
+
+// Arithmetic modulo an odd number in Montgomery form, x -> xR mod m with
+// R = 2^(64 * words). Every value is a vector of exactly as many words as the
+// modulus and products are reduced word by word (CIOS) so no division is
+// needed once the context has been built.
+class montgomery {
+  private:
+    std::vector<uint64_t> modulus;
+    uint64_t inverse; // -modulus^-1 mod 2^64
+    std::vector<uint64_t> r_squared;
+    mutable std::vector<uint64_t> scratch;
+    bool fixed_less(const uint64_t*, const uint64_t*) const;
+    void fixed_sub(uint64_t*, const uint64_t*) const;
+  public:
+    std::vector<uint64_t> one;
+    explicit montgomery(const std::vector<uint64_t>&);
+    std::vector<uint64_t> to_form(const std::vector<uint64_t>&) const;
+    void multiply(const std::vector<uint64_t>&, const std::vector<uint64_t>&,
+        std::vector<uint64_t>&) const;
+    void add(std::vector<uint64_t>&, const std::vector<uint64_t>&) const;
+    void sub(std::vector<uint64_t>&, const std::vector<uint64_t>&) const;
+    void half(std::vector<uint64_t>&) const;
+    std::vector<uint64_t> power(const std::vector<uint64_t>&, const std::vector<uint64_t>&) const;
+};
+
+bool montgomery::fixed_less(const uint64_t* a, const uint64_t* b) const {
+    for (uint64_t i = this->modulus.size() - 1; i != negative_one; --i) {
+        if (a[i] != b[i]) return a[i] < b[i];
+    }
+    return false;
+}
+
+// a -= b over the width of the modulus, dropping the final borrow.
+void montgomery::fixed_sub(uint64_t* a, const uint64_t* b) const {
+    uint64_t borrow = 0;
+    for (uint64_t i = 0; i < this->modulus.size(); ++i) {
+        uint64_t difference = a[i] - b[i] - borrow;
+        borrow = a[i] < b[i] || (a[i] == b[i] && borrow);
+        a[i] = difference;
+    }
+}
+
+montgomery::montgomery(const std::vector<uint64_t>& m)
+        : modulus(m), inverse(m[0]), scratch(m.size() + 2) {
+    for (uint64_t i = 0; i < 5; ++i) // Newton's iteration doubles the correct bits
+        this->inverse *= 2 - m[0] * this->inverse;
+    this->inverse = -this->inverse;
+    std::vector<uint64_t> power(1, 1), q;
+    words_shift_left(power, m.size() << 6);
+    words_div_mod(power, m, q, this->one);
+    power.assign(1, 1);
+    words_shift_left(power, m.size() << 7);
+    words_div_mod(power, m, q, this->r_squared);
+    this->one.resize(m.size(), 0);
+    this->r_squared.resize(m.size(), 0);
+}
+
+std::vector<uint64_t> montgomery::to_form(const std::vector<uint64_t>& a) const {
+    std::vector<uint64_t> q, r, result;
+    words_div_mod(a, this->modulus, q, r);
+    r.resize(this->modulus.size(), 0);
+    this->multiply(r, this->r_squared, result);
+    return result;
+}
+
+// result = a * b / R mod m. result may alias a or b.
+void montgomery::multiply(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b,
+        std::vector<uint64_t>& result) const {
+    uint64_t n = this->modulus.size();
+    uint64_t* t = this->scratch.data();
+    for (uint64_t i = 0; i < n + 2; ++i)
+        t[i] = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+        unsigned __int128 carry = 0;
+        for (uint64_t j = 0; j < n; ++j) {
+            carry += (unsigned __int128)a[j] * b[i] + t[j];
+            t[j] = uint64_t(carry);
+            carry >>= 64;
+        }
+        carry += t[n];
+        t[n] = uint64_t(carry);
+        t[n + 1] = uint64_t(carry >> 64);
+        uint64_t factor = t[0] * this->inverse;
+        carry = ((unsigned __int128)factor * this->modulus[0] + t[0]) >> 64;
+        for (uint64_t j = 1; j < n; ++j) {
+            carry += (unsigned __int128)factor * this->modulus[j] + t[j];
+            t[j - 1] = uint64_t(carry);
+            carry >>= 64;
+        }
+        carry += t[n];
+        t[n - 1] = uint64_t(carry);
+        t[n] = t[n + 1] + uint64_t(carry >> 64);
+    }
+    if (t[n] != 0 || !this->fixed_less(t, this->modulus.data()))
+        this->fixed_sub(t, this->modulus.data());
+    result.assign(t, t + n);
+}
+
+void montgomery::add(std::vector<uint64_t>& a, const std::vector<uint64_t>& b) const {
+    uint64_t carry = 0;
+    for (uint64_t i = 0; i < a.size(); ++i) {
+        unsigned __int128 sum = (unsigned __int128)a[i] + b[i] + carry;
+        a[i] = uint64_t(sum);
+        carry = uint64_t(sum >> 64);
+    }
+    if (carry != 0 || !this->fixed_less(a.data(), this->modulus.data()))
+        this->fixed_sub(a.data(), this->modulus.data());
+}
+
+void montgomery::sub(std::vector<uint64_t>& a, const std::vector<uint64_t>& b) const {
+    bool negative = this->fixed_less(a.data(), b.data());
+    this->fixed_sub(a.data(), b.data());
+    if (negative) {
+        unsigned __int128 carry = 0;
+        for (uint64_t i = 0; i < a.size(); ++i) {
+            carry += (unsigned __int128)a[i] + this->modulus[i];
+            a[i] = uint64_t(carry);
+            carry >>= 64;
+        }
+    }
+}
+
+// a = a / 2 mod m, adding m first when a is odd.
+void montgomery::half(std::vector<uint64_t>& a) const {
+    uint64_t carry = 0;
+    if (a[0] & 1) {
+        unsigned __int128 sum = 0;
+        for (uint64_t i = 0; i < a.size(); ++i) {
+            sum += (unsigned __int128)a[i] + this->modulus[i];
+            a[i] = uint64_t(sum);
+            sum >>= 64;
+        }
+        carry = uint64_t(sum);
+    }
+    for (uint64_t i = 0; i < a.size(); ++i) {
+        uint64_t above = i + 1 < a.size() ? a[i + 1] : carry;
+        a[i] = (a[i] >> 1) | (above << 63);
+    }
+}
+
+// Left to right exponentiation over 4 bit windows of the exponent, one
+// multiplication per window instead of one per set bit. base is in Montgomery
+// form and so is the result, exponent is a plain word vector.
+std::vector<uint64_t> montgomery::power(const std::vector<uint64_t>& base,
+        const std::vector<uint64_t>& exponent) const {
+    std::vector<std::vector<uint64_t>> powers(16);
+    powers[0] = this->one;
+    for (uint64_t i = 1; i < 16; ++i)
+        this->multiply(powers[i - 1], base, powers[i]);
+    std::vector<uint64_t> result = this->one;
+    uint64_t windows = (words_bit_length(exponent) + 3) >> 2;
+    for (uint64_t w = windows - 1; w != negative_one; --w) {
+        for (uint64_t i = 0; i < 4 && w != windows - 1; ++i)
+            this->multiply(result, result, result);
+        uint64_t digit = (exponent[w >> 4] >> ((w & 15) << 2)) & 15;
+        if (digit != 0)
+            this->multiply(result, powers[digit], result);
+    }
+    return result;
+}
+
+// Strong probable prime test to the given base, which is in Montgomery form.
+bool miller_rabin(const montgomery& field, const std::vector<uint64_t>& n,
+        const std::vector<uint64_t>& base) {
+    std::vector<uint64_t> d = n, minus_one(n.size(), 0);
+    d[0] ^= 1; // n is odd
+    uint64_t s = words_count_trailing_zeros(d);
+    words_shift_right(d, s);
+    field.sub(minus_one, field.one);
+    std::vector<uint64_t> x = field.power(base, d);
+    if (x == field.one || x == minus_one) return true;
+    for (uint64_t i = 1; i < s; ++i) {
+        field.multiply(x, x, x);
+        if (x == minus_one) return true;
+        if (x == field.one) return false;
+    }
+    return false;
+}
+
+// Strong Lucas probable prime test with Selfridge's parameters: the first D
+// in 5, -7, 9, -11, ... with Jacobi symbol (D / n) = -1, P = 1 and
+// Q = (1 - D) / 4. n must be odd, not a perfect square and have no factor
+// below TRIAL_DIVISION_LIMIT.
+bool strong_lucas(const montgomery& field, const std::vector<uint64_t>& n) {
+    int64_t D = 5;
+    while (true) {
+        uint64_t magnitude = uint64_t(D < 0 ? -D : D);
+        int symbol = jacobi_word(words_mod_word(n, magnitude), magnitude);
+        if ((magnitude & 3) == 3 && (n[0] & 3) == 3) symbol = -symbol;
+        if (D < 0 && (n[0] & 3) == 3) symbol = -symbol;
+        if (symbol == -1) break;
+        if (symbol == 0) return false;
+        D = D < 0 ? 2 - D : -D - 2;
+    }
+    std::vector<uint64_t> zero(n.size(), 0), d_form, q_form;
+    int64_t Q = (1 - D) / 4;
+    d_form = field.to_form(std::vector<uint64_t>(1, uint64_t(D < 0 ? -D : D)));
+    q_form = field.to_form(std::vector<uint64_t>(1, uint64_t(Q < 0 ? -Q : Q)));
+    if (D < 0) {
+        std::vector<uint64_t> negated = zero;
+        field.sub(negated, d_form);
+        d_form.swap(negated);
+    }
+    if (Q < 0) {
+        std::vector<uint64_t> negated = zero;
+        field.sub(negated, q_form);
+        q_form.swap(negated);
+    }
+    std::vector<uint64_t> d = n;
+    words_add(d, std::vector<uint64_t>(1, 1));
+    uint64_t s = words_count_trailing_zeros(d);
+    words_shift_right(d, s);
+    std::vector<uint64_t> U = field.one, V = field.one, Qk = q_form, t;
+    for (uint64_t bit = words_bit_length(d) - 2; bit != negative_one; --bit) {
+        field.multiply(U, V, U); // U_2k = U_k V_k
+        field.multiply(V, V, V); // V_2k = V_k^2 - 2Q^k
+        field.sub(V, Qk);
+        field.sub(V, Qk);
+        field.multiply(Qk, Qk, Qk);
+        if ((d[bit >> 6] >> (bit & 63)) & 1) {
+            t = U; // U_2k+1 = (U_2k + V_2k) / 2
+            field.add(U, V);
+            field.half(U);
+            field.multiply(t, d_form, t); // V_2k+1 = (D U_2k + V_2k) / 2
+            field.add(V, t);
+            field.half(V);
+            field.multiply(Qk, q_form, Qk);
+        }
+    }
+    if (U == zero || V == zero) return true;
+    for (uint64_t r = 1; r < s; ++r) {
+        field.multiply(V, V, V);
+        field.sub(V, Qk);
+        field.sub(V, Qk);
+        if (V == zero) return true;
+        field.multiply(Qk, Qk, Qk);
+    }
+    return false;
+}
+
+} // End anonymous namespace
+
+// Baillie-PSW: trial division, a strong probable prime test to base 2 and a
+// strong Lucas test. No composite is known to pass. Each extra round adds a
+// Miller-Rabin test to a pseudo-random base.
+bool is_probable_prime(const uInt& n, const uint64_t& rounds) {
+    std::vector<uint64_t> words = to_words(n);
+    if (words.empty()) return false;
+    if (words.size() == 1 && words[0] < 4) return words[0] > 1;
+    if ((words[0] & 1) == 0) return false;
+    const trial_division_table& table = trial_division_primes();
+    uint64_t begin = 0;
+    for (uint64_t g = 0; g < table.products.size(); ++g) {
+        uint64_t remainder = words_mod_word(words, table.products[g]);
+        for (uint64_t i = begin; i < table.group_ends[g]; ++i) {
+            if (remainder % table.primes[i] == 0)
+                return words.size() == 1 && words[0] == table.primes[i];
+        }
+        begin = table.group_ends[g];
+    }
+    if (words.size() == 1 && words[0] < TRIAL_DIVISION_LIMIT * TRIAL_DIVISION_LIMIT)
+        return true;
+    montgomery field(words);
+    if (!miller_rabin(field, words, field.to_form(std::vector<uint64_t>(1, 2))))
+        return false;
+    std::vector<uint64_t> root = root_words(words, 2);
+    if (words_mul(root, root) == words) return false;
+    if (!strong_lucas(field, words)) return false;
+    std::vector<uint64_t> range = words, base(words.size()), q, r;
+    words_sub(range, std::vector<uint64_t>(1, 3));
+    uint64_t state = words[0]; // splitmix64
+    for (uint64_t i = 0; i < rounds; ++i) {
+        for (uint64_t j = 0; j < base.size(); ++j) {
+            uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            base[j] = z ^ (z >> 31);
+        }
+        words_normalize(base);
+        words_div_mod(base, range, q, r);
+        words_add(r, std::vector<uint64_t>(1, 2)); // in [2, n - 2]
+        if (!miller_rabin(field, words, field.to_form(r))) return false;
+        base.resize(words.size());
+    }
+    return true;
+}
+
+// Returns the smallest probable prime greater than n. The remainders of the
+// candidate by every trial division prime are kept up to date as it advances
+// by two, so candidates with a small factor are skipped without touching the
+// full value.
+uInt next_prime(const uInt& n) {
+    if (n < TWO) return TWO;
+    uInt candidate = n;
+    candidate += candidate.test_bit(0) ? TWO : ONE;
+    while (candidate.bit_length() < 64 && uint64_t(candidate) < TRIAL_DIVISION_LIMIT) {
+        if (is_probable_prime(candidate)) return candidate;
+        candidate += TWO;
+    }
+    const std::vector<uint64_t>& primes = trial_division_primes().primes;
+    std::vector<uint64_t> words = to_words(candidate), residues(primes.size());
+    for (uint64_t i = 0; i < primes.size(); ++i)
+        residues[i] = words_mod_word(words, primes[i]);
+    uint64_t offset = 0;
+    while (true) {
+        bool composite = false;
+        for (uint64_t i = 0; i < primes.size() && !composite; ++i)
+            composite = residues[i] == 0;
+        if (!composite) {
+            uInt next = candidate;
+            next += uInt(offset);
+            if (is_probable_prime(next)) return next;
+        }
+        offset += 2;
+        for (uint64_t i = 0; i < primes.size(); ++i) {
+            residues[i] += 2;
+            if (residues[i] >= primes[i]) residues[i] -= primes[i];
+        }
+    }
+}
+
+// Tests every candidate with is_probable_prime, spread over the given number
+// of threads (all hardware threads by default). Each thread claims the next
+// untested candidate, so uneven sizes still balance.
+std::vector<bool> probable_primes(const std::vector<uInt>& candidates,
+        const uint64_t& rounds, uint64_t threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    if (threads > candidates.size()) threads = candidates.size();
+    std::vector<char> results(candidates.size(), 0); // vector<bool> writes would race
+    std::atomic<uint64_t> next(0);
+    std::vector<std::thread> workers;
+    for (uint64_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            for (uint64_t i = next++; i < candidates.size(); i = next++)
+                results[i] = is_probable_prime(candidates[i], rounds);
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+    return std::vector<bool>(results.begin(), results.end());
+}
+
+// =========================== Performance Testing ============================
+
+#ifdef PERFORMANCE_TEST
+static const char* performance_test_names[NUM_OF_TESTS] = {
+    "REMOVE_LEAD_ZEROS", "INT TO UINT", "STRING TO UINT", "COPY", "ADDITION",
+    "SUBTRACTION", "MULTIPLICATION", "DIVISION", "MODULO", "SHIFT LEFT",
+    "SHIFT RIGHT", "BITWISE AND", "BITWISE OR", "BITWISE XOR", "EQUAL TO",
+    "NOT EQUAL TO", "LESS THAN", "GREATER THAN", "LESS THAN OR EQUAL TO",
+    "GREATER THAN OR EQUAL TO", "UINT TO INT", "UINT TO STRING"
+};
+
+static const char* performance_tier_names[NUM_OF_TIERS] = { "basecase", "karatsuba" };
+
+#ifdef HARDWARE_COUNTERS
+static const char* hardware_counter_names[NUM_OF_HARDWARE_COUNTERS] = {
+    "cycles", "instructions", "l1d_read_misses", "llc_misses", "branch_misses"
+};
+
+// Whether any thread managed to open the given hardware counter.
+bool hardware_counter_opened(const uint64_t& c) {
+    performance_registry& registry = get_performance_registry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    return registry.hardware_opened[c];
+}
+#endif
+
+// Merges the counters of every thread, live or exited, into one table indexed
+// by the operation enum.
+std::vector<operation_totals> merge_performance_counters() {
+    performance_registry& registry = get_performance_registry();
+    double tick_length = performance_tick_length();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    std::vector<operation_totals> totals = registry.retired;
+    for (auto counters : registry.threads)
+        add_counters(totals, *counters, tick_length);
+    return totals;
+}
+
+#ifdef MEMORY_ACCOUNTING
+memory_usage process_memory_usage() {
+    performance_registry& registry = get_performance_registry();
+    memory_usage usage = { registry.allocations.load(), registry.allocated_bytes.load(),
+        registry.freed_bytes.load(), registry.live_bytes.load(), registry.peak_bytes.load() };
+    return usage;
+}
+#endif
+
+// Returns the merged counters as a JSON array with one object per operation.
+// sizes maps each algorithm tier to a list of [bucket, count] pairs, where
+// bucket i counts operations whose operands totalled [2^(i - 1), 2^i) bits.
+std::string performance_test_json() {
+    std::vector<operation_totals> totals = merge_performance_counters();
+    std::ostringstream json;
+    json << "[";
+    for (uint64_t i = 0; i < NUM_OF_TESTS; ++i) {
+        json << (i == 0 ? "\n" : ",\n") << "  {\"operation\": \"" << performance_test_names[i]
+            << "\", \"calls\": " << totals[i].calls << ", \"milliseconds\": "
+            << totals[i].milliseconds << ", \"bytes\": " << totals[i].bytes << ", \"sizes\": {";
+        for (uint64_t t = 0; t < NUM_OF_TIERS; ++t) {
+            json << (t == 0 ? "" : ", ") << "\"" << performance_tier_names[t] << "\": [";
+            bool first = true;
+            for (uint64_t b = 0; b < SIZE_BUCKETS; ++b) {
+                if (totals[i].sizes[t][b] == 0) continue;
+                json << (first ? "" : ", ") << "[" << b << ", " << totals[i].sizes[t][b] << "]";
+                first = false;
+            }
+            json << "]";
+        }
+        json << "}";
+        #ifdef MEMORY_ACCOUNTING
+            json << ", \"memory\": {\"allocations\": " << totals[i].allocations
+                << ", \"allocated_bytes\": " << totals[i].allocated_bytes
+                << ", \"freed_bytes\": " << totals[i].freed_bytes
+                << ", \"peak_bytes\": " << totals[i].peak_bytes << "}";
+        #endif
+        #ifdef HARDWARE_COUNTERS
+            // Each counter maps to [bucket, total] pairs over the same buckets,
+            // or null when it could not be opened.
+            json << ", \"hardware\": {";
+            for (uint64_t c = 0; c < NUM_OF_HARDWARE_COUNTERS; ++c) {
+                json << (c == 0 ? "" : ", ") << "\"" << hardware_counter_names[c] << "\": ";
+                if (!hardware_counter_opened(c)) {
+                    json << "null";
+                    continue;
+                }
+                json << "[";
+                bool first = true;
+                for (uint64_t b = 0; b < SIZE_BUCKETS; ++b) {
+                    uint64_t calls = 0;
+                    for (uint64_t t = 0; t < NUM_OF_TIERS; ++t)
+                        calls += totals[i].sizes[t][b];
+                    if (calls == 0) continue;
+                    json << (first ? "" : ", ") << "[" << b << ", " << totals[i].hardware[b][c] << "]";
+                    first = false;
+                }
+                json << "]";
+            }
+            json << "}";
+        #endif
+        json << "}";
+    }
+    json << "\n]\n";
+    return json.str();
+}
+
+void print_performance_test_results() {
+    std::vector<operation_totals> totals = merge_performance_counters();
+    double total = 0.0;
+    for (auto& op : totals) {
+        total += op.milliseconds;
+    }
+    std::cout << std::endl << "PERFORMANCE TEST RESULTS" << std::endl;
+    std::cout << "======================================================" << std::endl;
+    for (uint64_t i = 0; i < NUM_OF_TESTS; ++i) {
+        double time = totals[i].milliseconds;
+        std::cout << std::setw(27) << performance_test_names[i];
+        std::cout << " || " << std::setw(8) << time << "ms, " << (total == 0.0 ? 0.0 : time / total * 100) << "%"
+            << ", " << totals[i].calls << " calls" << std::endl;
+    }
+    #ifdef MEMORY_ACCOUNTING
+        std::cout << std::endl << "MEMORY" << std::endl;
+        std::cout << "======================================================" << std::endl;
+        std::cout << std::setw(27) << "" << " || " << std::setw(12) << "ALLOCATIONS"
+            << std::setw(16) << "ALLOCATED" << std::setw(16) << "FREED"
+            << std::setw(14) << "PEAK LIMBS" << std::endl;
+        for (uint64_t i = 0; i < NUM_OF_TESTS; ++i) {
+            if (totals[i].allocations == 0 && totals[i].freed_bytes == 0) continue;
+            std::cout << std::setw(27) << performance_test_names[i] << " || "
+                << std::setw(12) << totals[i].allocations
+                << std::setw(16) << totals[i].allocated_bytes
+                << std::setw(16) << totals[i].freed_bytes
+                << std::setw(14) << (totals[i].peak_bytes >> 3) << std::endl;
+        }
+        memory_usage usage = process_memory_usage();
+        std::cout << std::setw(27) << "WHOLE PROCESS" << " || "
+            << std::setw(12) << usage.allocations << std::setw(16) << usage.allocated_bytes
+            << std::setw(16) << usage.freed_bytes << std::setw(14) << (usage.peak_bytes >> 3)
+            << std::endl << usage.live_bytes << " bytes still live" << std::endl;
+    #endif
+    #ifdef HARDWARE_COUNTERS
+        std::cout << std::endl << "HARDWARE COUNTERS" << std::endl;
+        std::cout << "======================================================" << std::endl;
+        bool any = false;
+        for (uint64_t c = 0; c < NUM_OF_HARDWARE_COUNTERS; ++c)
+            any |= hardware_counter_opened(c);
+        if (!any) {
+            std::cout << "Unavailable: perf_event_open could not open any counter" << std::endl;
+            return;
+        }
+        std::cout << std::setw(27) << "" << " || " << std::setw(14) << "CYCLES" << std::setw(14)
+            << "INSTRUCTIONS" << std::setw(8) << "IPC" << std::setw(14) << "L1D MISSES"
+            << std::setw(14) << "LLC MISSES" << std::setw(14) << "BRANCH MISSES" << std::endl;
+        for (uint64_t i = 0; i < NUM_OF_TESTS; ++i) {
+            if (totals[i].calls == 0) continue;
+            uint64_t sums[NUM_OF_HARDWARE_COUNTERS] = {};
+            for (uint64_t b = 0; b < SIZE_BUCKETS; ++b) {
+                for (uint64_t c = 0; c < NUM_OF_HARDWARE_COUNTERS; ++c)
+                    sums[c] += totals[i].hardware[b][c];
+            }
+            std::cout << std::setw(27) << performance_test_names[i] << " || ";
+            for (uint64_t c = 0; c < NUM_OF_HARDWARE_COUNTERS; ++c) {
+                if (c == L1D_MISS_COUNTER) {
+                    double ipc = sums[CYCLES_COUNTER] == 0 ? 0.0
+                        : double(sums[INSTRUCTIONS_COUNTER]) / sums[CYCLES_COUNTER];
+                    std::cout << std::setw(8) << std::setprecision(3) << ipc << std::setprecision(6);
+                }
+                if (hardware_counter_opened(c)) std::cout << std::setw(14) << sums[c];
+                else std::cout << std::setw(14) << "n/a";
+            }
+            std::cout << std::endl;
+        }
+    #endif
+}
+#endif
+
+} // End namespace atn
@@ -13,27 +13,55 @@
 // Optimize this implementation until I can calculate the fibonacci sequence at
 // 100,000 in under 2 mins with optimization flag -O3
 
+// This header only declares the library. The definitions are compiled from
+// uInt.cpp and word_kernels.cpp into lib/libuInt.a by the Makefile, and only
+// templates, constants and the few helpers needed inline on every call are
+// defined here. The library has to be built with the same PERFORMANCE_TEST,
+// HARDWARE_COUNTERS and MEMORY_ACCOUNTING flags as the program using it.
+
 #ifndef _UINTEGER_UINT_HPP_
 #define _UINTEGER_UINT_HPP_
 
 #include <climits> // CHAR_BIT
+#include <istream> // std::istream
 #include <numeric> // std::accumulate
+#include <ostream> // std::ostream
 #include <stdexcept> // runtime_error
 #include <string> // std::string
+#include <utility> // std::move
 #include <vector> // std::vector
+#if defined(MEMORY_ACCOUNTING) && !defined(PERFORMANCE_TEST)
+    #define PERFORMANCE_TEST // memory is reported with the other counters
+#endif
 #ifdef PERFORMANCE_TEST
+    #include <atomic> // std::atomic
     #include <iomanip> // std::setw
     #include <iostream> // std::cout
     #include <chrono> // std::chrono
+    #include <mutex> // std::mutex
+    #include <sstream> // std::ostringstream
 #endif
 
 #define KARATSUBA_BOUNDARY 640
 
+// libstdc++ packs a std::vector<bool> into 64 bit words with bit i stored in
+// bit i % 64 of word i / 64. When that layout is available the word kernels
+// below work on whole words instead of one bit at a time.
+#if defined(__GLIBCXX__) && __SIZEOF_LONG__ == 8
+    #define WORD_ACCESS
+#endif
+#define DECIMAL_BLOCK 10000000000000000000ull // 10^19, the largest in a word
+#define DECIMAL_BLOCK_DIGITS 19
+
 // ====================== Performance Testing Variables =======================
 
+// Every instrumented operation opens a PERFORMANCE_SCOPE, which counts the
+// call, its duration, the operand bytes it processed and the size of its
+// operands in a per thread table, so threads never share a counter. Only the
+// outermost scope of an operation is recorded, so recursion (karatsuba calling
+// back into operator*=) is not counted twice. The tables of every thread are
+// merged when results are read.
 #ifdef PERFORMANCE_TEST
-    #define TEST_RESOLUTION std::chrono::duration<double, std::milli>
-    #define CLOCK std::chrono::high_resolution_clock
     enum {
         REMOVE_LEAD_ZEROS_TIME,
         INT_TO_UINT_TIME,
@@ -59,16 +87,221 @@
         UINT_TO_STRING_TIME,
         NUM_OF_TESTS
     };
-    std::vector<std::chrono::time_point<CLOCK>> start_times(NUM_OF_TESTS);
-    std::vector<TEST_RESOLUTION> durations(NUM_OF_TESTS);
-    auto stop = std::chrono::high_resolution_clock::now();
-    auto duration = stop - stop;
-    #define START_TEST(x) \
-        start_times[x] = CLOCK::now();
-    #define END_TEST(x) \
-        stop = CLOCK::now(); \
-        duration = stop - start_times[x]; \
-        durations[x] += duration;
+    // The algorithm an operation used, for the operand size histograms.
+    enum {
+        BASECASE_TIER,
+        KARATSUBA_TIER,
+        NUM_OF_TIERS
+    };
+    #define SIZE_BUCKETS 65 // bucket i counts operands of bit length in [2^(i - 1), 2^i)
+    #ifdef HARDWARE_COUNTERS
+        enum {
+            CYCLES_COUNTER,
+            INSTRUCTIONS_COUNTER,
+            L1D_MISS_COUNTER,
+            LLC_MISS_COUNTER,
+            BRANCH_MISS_COUNTER,
+            NUM_OF_HARDWARE_COUNTERS
+        };
+    #endif
+    #define PERFORMANCE_SCOPE(x, bits) \
+        atn::performance_scope performance_scope_instance(x, bits);
+    #define PERFORMANCE_TIER(x) \
+        performance_scope_instance.tier = x;
+
+namespace atn { // AaronTheNerd
+
+// Reads a cheap monotonic tick counter: the time stamp counter on x86-64 and
+// a nanosecond clock elsewhere. Ticks are converted to nanoseconds when the
+// results are read.
+inline uint64_t performance_ticks() {
+    #if defined(__x86_64__)
+        return __builtin_ia32_rdtsc();
+    #else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    #endif
+}
+
+#ifdef HARDWARE_COUNTERS
+// The hardware events of one thread, opened as a single perf_event_open group
+// so that one read() returns all of them. Events the CPU or kernel does not
+// support are left out of the group. When the group cannot be opened at all,
+// for example in a virtual machine without a PMU or when
+// /proc/sys/kernel/perf_event_paranoid forbids it, nothing is counted.
+class hardware_counter_group {
+  private:
+    int fds[NUM_OF_HARDWARE_COUNTERS];
+    uint64_t members;
+    uint64_t order[NUM_OF_HARDWARE_COUNTERS]; // position of each member in a group read
+  public:
+    bool opened[NUM_OF_HARDWARE_COUNTERS];
+    hardware_counter_group();
+    ~hardware_counter_group();
+    bool available() const;
+    void read_values(uint64_t*) const;
+};
+
+#endif
+
+// Counters are only written by their own thread. Relaxed atomics keep reads
+// from other threads well defined without making the writes any slower.
+struct operation_counters {
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> ticks;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> sizes[NUM_OF_TIERS][SIZE_BUCKETS];
+    #ifdef HARDWARE_COUNTERS
+        std::atomic<uint64_t> hardware[SIZE_BUCKETS][NUM_OF_HARDWARE_COUNTERS];
+    #endif
+    #ifdef MEMORY_ACCOUNTING
+        std::atomic<uint64_t> allocations;
+        std::atomic<uint64_t> allocated_bytes;
+        std::atomic<uint64_t> freed_bytes;
+        std::atomic<uint64_t> peak_bytes; // largest growth in live bytes during one call
+    #endif
+};
+
+// A merged copy of the counters of one operation.
+struct operation_totals {
+    uint64_t calls;
+    double milliseconds;
+    uint64_t bytes;
+    uint64_t sizes[NUM_OF_TIERS][SIZE_BUCKETS];
+    #ifdef HARDWARE_COUNTERS
+        uint64_t hardware[SIZE_BUCKETS][NUM_OF_HARDWARE_COUNTERS];
+    #endif
+    #ifdef MEMORY_ACCOUNTING
+        uint64_t allocations;
+        uint64_t allocated_bytes;
+        uint64_t freed_bytes;
+        uint64_t peak_bytes;
+    #endif
+};
+
+inline void add_relaxed(std::atomic<uint64_t>& counter, const uint64_t& value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+class thread_performance_counters {
+  public:
+    operation_counters operations[NUM_OF_TESTS];
+    uint64_t depth[NUM_OF_TESTS];
+    #ifdef HARDWARE_COUNTERS
+        hardware_counter_group hardware;
+    #endif
+    #ifdef MEMORY_ACCOUNTING
+        uint64_t current; // the outermost operation running, NUM_OF_TESTS if none
+        int64_t live_bytes; // allocated minus freed by this thread
+        int64_t high_bytes; // the most live_bytes has been since current started
+    #endif
+    thread_performance_counters();
+    ~thread_performance_counters();
+};
+
+// Each thread's counters, defined in uInt.cpp.
+extern thread_local thread_performance_counters performance_counters;
+
+#ifdef MEMORY_ACCOUNTING
+// Counts an allocation (positive bytes) or a free (negative bytes) of uInt
+// storage against the process and the operation running on this thread.
+void account_memory(const int64_t&);
+
+// The allocator behind uInt::bits when MEMORY_ACCOUNTING is defined. It
+// forwards to std::allocator and reports every allocation and free.
+template <typename T>
+struct accounting_allocator {
+    typedef T value_type;
+    accounting_allocator() {}
+    template <typename U>
+    accounting_allocator(const accounting_allocator<U>&) {}
+    T* allocate(std::size_t n) {
+        account_memory(int64_t(n * sizeof(T)));
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n) {
+        account_memory(-int64_t(n * sizeof(T)));
+        std::allocator<T>().deallocate(p, n);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const accounting_allocator<T>&, const accounting_allocator<U>&) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const accounting_allocator<T>&, const accounting_allocator<U>&) {
+    return false;
+}
+#endif
+
+class performance_scope {
+  private:
+    uint64_t test;
+    uint64_t bits;
+    uint64_t start;
+    #ifdef HARDWARE_COUNTERS
+        uint64_t hardware_start[NUM_OF_HARDWARE_COUNTERS];
+    #endif
+    #ifdef MEMORY_ACCOUNTING
+        bool outermost;
+        int64_t base_bytes;
+        int64_t saved_high_bytes;
+    #endif
+  public:
+    uint64_t tier;
+    performance_scope(const uint64_t& x, const uint64_t& operand_bits)
+            : test(x), bits(operand_bits), start(0), tier(BASECASE_TIER) {
+        #ifdef MEMORY_ACCOUNTING
+            // Memory is attributed to the outermost operation of any kind.
+            this->outermost = performance_counters.current == NUM_OF_TESTS;
+            if (this->outermost) {
+                performance_counters.current = x;
+                this->base_bytes = performance_counters.live_bytes;
+                this->saved_high_bytes = performance_counters.high_bytes;
+                performance_counters.high_bytes = performance_counters.live_bytes;
+            }
+        #endif
+        if (performance_counters.depth[x]++ != 0) return;
+        #ifdef HARDWARE_COUNTERS
+            if (performance_counters.hardware.available())
+                performance_counters.hardware.read_values(this->hardware_start);
+        #endif
+        this->start = performance_ticks();
+    }
+    ~performance_scope() {
+        #ifdef MEMORY_ACCOUNTING
+            if (this->outermost) {
+                operation_counters& owner = performance_counters.operations[this->test];
+                uint64_t growth = uint64_t(performance_counters.high_bytes - this->base_bytes);
+                if (growth > owner.peak_bytes.load(std::memory_order_relaxed))
+                    owner.peak_bytes.store(growth, std::memory_order_relaxed);
+                if (this->saved_high_bytes > performance_counters.high_bytes)
+                    performance_counters.high_bytes = this->saved_high_bytes;
+                performance_counters.current = NUM_OF_TESTS;
+            }
+        #endif
+        if (--performance_counters.depth[this->test] != 0) return;
+        uint64_t stop = performance_ticks();
+        uint64_t bucket = this->bits == 0 ? 0 : 64 - __builtin_clzll(this->bits);
+        operation_counters& op = performance_counters.operations[this->test];
+        #ifdef HARDWARE_COUNTERS
+            if (performance_counters.hardware.available()) {
+                uint64_t values[NUM_OF_HARDWARE_COUNTERS];
+                performance_counters.hardware.read_values(values);
+                for (uint64_t c = 0; c < NUM_OF_HARDWARE_COUNTERS; ++c)
+                    add_relaxed(op.hardware[bucket][c], values[c] - this->hardware_start[c]);
+            }
+        #endif
+        add_relaxed(op.ticks, stop - this->start);
+        add_relaxed(op.calls, 1);
+        add_relaxed(op.bytes, (this->bits + 7) >> 3);
+        add_relaxed(op.sizes[this->tier][bucket], 1);
+    }
+};
+
+} // End namespace atn
 #endif
 
 namespace atn { // AaronTheNerd
@@ -77,28 +310,85 @@ namespace atn { // AaronTheNerd
 // ============================== Predefinitions ==============================
 // ============================================================================
 
+// The storage behind uInt::bits, counted by accounting_allocator when
+// MEMORY_ACCOUNTING is defined.
+#ifdef MEMORY_ACCOUNTING
+    typedef std::vector<bool, accounting_allocator<bool>> bit_vector;
+#else
+    typedef std::vector<bool> bit_vector;
+#endif
+
+class uInt;
+
+// A read-only window onto bits [offset, offset + length) of a uInt or of an
+// array of 64 bit words, least significant word first. A view does not own
+// or copy anything and slicing it never allocates, so it only stays valid
+// while the value it looks at is alive and unchanged. The length is trimmed
+// to the highest set bit in the window, so a view's bit_length() matches the
+// bit_length() of the uInt it would copy out to.
+class uInt_view {
+  private:
+    // =========================== Private Methods ============================
+    bool source_bit(const uint64_t&) const;
+    uint64_t source_word(const uint64_t&) const;
+    void trim();
+    const bit_vector* bits;
+    const uint64_t* words;
+    uint64_t source_length;
+    uint64_t offset;
+    uint64_t length;
+  public:
+    // ============================= Constructors =============================
+    uInt_view();
+    uInt_view(const uInt&);
+    uInt_view(const uInt&, const uint64_t&, const uint64_t&);
+    uInt_view(const uint64_t*, const uint64_t&);
+    // ================================ Slices ================================
+    uInt_view low_bits(const uint64_t&) const;
+    uInt_view high_words(const uint64_t&) const;
+    uInt_view window(const uint64_t&, const uint64_t&) const;
+    // ============================== To String ===============================
+    std::string to_string() const;
+    std::string to_string(const uint64_t&) const;
+    // ============================= Bit Queries ==============================
+    uint64_t bit_length() const;
+    uint64_t popcount() const;
+    uint64_t count_trailing_zeros() const;
+    bool test_bit(const uint64_t&) const;
+    uint64_t word(const uint64_t&) const;
+};
+
 class uInt {
   private:
     // =========================== Private Methods ============================
     std::pair<uInt, uInt> div_and_mod(const uInt&) const;
+    uint64_t div_and_mod_word(const uint64_t&);
+    uint64_t low_word() const;
+    std::vector<uint64_t> decimal_blocks() const;
     void remove_lead_zeros();
-    void convert_binary_string(std::string);
-    void convert_hex_string(std::string);
+    void convert_power_of_two_string(const std::string&, const uint64_t&);
+    void convert_radix_string(const std::string&, const uint64_t&);
+    uint64_t power_of_two_digit(const uint64_t&, const uint64_t&) const;
     inline bool odd(char) const;
     std::string div_by_2(std::string) const;
     void convert_decimal_string(std::string);
-    uInt karatsuba(const uInt&) const;
+    static uInt karatsuba(const uInt_view&, const uInt_view&);
   public:
-    std::vector<bool> bits;
+    bit_vector bits;
     // ============================= Constructors =============================
     uInt();
     uInt(const uint64_t&);
     explicit uInt(const std::string&);
+    uInt(const std::string&, const uint64_t&);
     uInt(const uInt&);
+    uInt(uInt&&) noexcept;
+    explicit uInt(const uInt_view&);
     // ============================== To String ===============================
     std::string to_string() const;
     std::string to_string(const uint64_t&) const;
     // ============================== Assignment ==============================
+    uInt& operator=(const uInt&);
+    uInt& operator=(uInt&&) noexcept;
     uInt& operator+=(const uInt&);
     uInt& operator-=(const uInt&);
     uInt& operator*=(const uInt&);  
@@ -109,12 +399,25 @@ class uInt {
     uInt& operator&=(const uInt&);
     uInt& operator|=(const uInt&);
     uInt& operator^=(const uInt&);
+    uInt& operator+=(const uint64_t&);
+    uInt& operator-=(const uint64_t&);
+    uInt& operator*=(const uint64_t&);
+    uInt& operator/=(const uint64_t&);
+    uInt& operator%=(const uint64_t&);
+    uInt& operator+=(const uInt_view&);
+    uInt& operator-=(const uInt_view&);
+    uInt& operator*=(const uInt_view&);
     // ============================== Arithmetic ==============================
     uInt& operator+(const uInt&) const;
     uInt& operator-(const uInt&) const;
     uInt& operator*(const uInt&) const;
     uInt& operator/(const uInt&) const;
     uInt& operator%(const uInt&) const;
+    uInt operator+(const uint64_t&) const;
+    uInt operator-(const uint64_t&) const;
+    uInt operator*(const uint64_t&) const;
+    uInt operator/(const uint64_t&) const;
+    uInt operator%(const uint64_t&) const;
     uInt& operator<<(const uint64_t&) const;
     uInt& operator>>(const uint64_t&) const;
     uInt& operator&(const uInt&) const;
@@ -130,964 +433,260 @@ class uInt {
     bool operator>(const uInt&) const;
     bool operator<=(const uInt&) const;
     bool operator>=(const uInt&) const;
+    bool operator==(const uint64_t&) const;
+    bool operator!=(const uint64_t&) const;
+    bool operator<(const uint64_t&) const;
+    bool operator>(const uint64_t&) const;
+    bool operator<=(const uint64_t&) const;
+    bool operator>=(const uint64_t&) const;
+    // ============================= Bit Queries ==============================
+    uint64_t bit_length() const;
+    uint64_t popcount() const;
+    uint64_t count_trailing_zeros() const;
+    bool test_bit(const uint64_t&) const;
+    uInt& set_bit(const uint64_t&);
+    uInt& clear_bit(const uint64_t&);
     // =============================== Casting ================================
     explicit operator uint64_t() const;
+    // ========================= Binary Import/Export =========================
+    friend void import_bits(uInt&, const uint64_t&, const int&,
+        const uint64_t&, const int&, const uint64_t&, const void*);
+    friend uint64_t export_bits(void*, const int&, const uint64_t&,
+        const int&, const uint64_t&, const uInt&);
+    // =============================== Streams ================================
+    friend std::ostream& operator<<(std::ostream&, const uInt&);
+    friend std::istream& operator>>(std::istream&, uInt&);
 };
 
-// ============================= Helper Variables =============================
-
-static constexpr uint64_t const& negative_one = uint64_t(-1);
-
-const std::string base64_index("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
-const std::string base_n_index("0123456789abcdefghijklmnopqrstuvwxyz");
-
-const uInt ZERO = uInt(0);
-const uInt ONE = uInt(1);
-const uInt TWO = uInt(2);
-const uInt THREE = uInt(3);
-const uInt FOUR = uInt(4);
-const uInt FIVE = uInt(5);
-const uInt SIX = uInt(6);
-const uInt SEVEN = uInt(7);
-const uInt EIGHT = uInt(8);
-const uInt NINE = uInt(9);
-const uInt TEN = uInt(10);
-
-// ============================================================================
-// =============================== Definitions ================================
-// ============================================================================
-
-// ============================= Private Methods ==============================
-
-// Performs a simultaneous division and modulo operation and returns a pair
-// containing the results where the first item in the pair is an atn::uInt
-// representing the result of the division and the second is an atn::uInt
-// representing the result of the modulo.
-std::pair<uInt, uInt> uInt::div_and_mod(const uInt& n) const {
-    /*
-    Potential micro optimizations
-    1. Iterator vs. **uint64_t index**
-    2. Setting the quotient's value to `mod >= n` vs. **to true or false.**
-    3. Adding quotient[i] / *it's value to mod directly vs. **if statement**
-    */
-    if (n == ZERO) {
-        throw std::runtime_error("ERROR: Divide/Mod by 0 Exception");
-    }
-    if (this->bits.size() == 0) {
-        return std::make_pair(*this, *this);
-    }
-    uInt quotient(*this), mod;
-    for (uint64_t i = quotient.bits.size() - 1; i != negative_one; --i) {
-        mod <<= 1;
-        if (quotient.bits[i]) ++mod;
-        if (mod >= n) {
-            quotient.bits[i] = true;
-            mod -= n;
-        } else {
-            quotient.bits[i] = false;
-        }
-    }
-    mod.remove_lead_zeros();
-    quotient.remove_lead_zeros();
-    return std::make_pair(quotient, mod);
-}
-
-void uInt::remove_lead_zeros() {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(REMOVE_LEAD_ZEROS_TIME)
-    #endif
-    while (this->bits.size() != 0 && !this->bits.back())
-        this->bits.pop_back();
-    #ifdef PERFORMANCE_TEST
-        END_TEST(REMOVE_LEAD_ZEROS_TIME)
-    #endif
-}
-
-void uInt::convert_binary_string(std::string str) {
-    for (auto it = str.rbegin(); it != str.rend(); ++it) {
-        if (*it != '1' && *it != '0') {
-            this->bits.clear();
-            throw std::runtime_error("ERROR: Cannot input non-binary digits");
-        }
-        this->bits.emplace_back(*it == '1');
-    }
-}
-
-void uInt::convert_hex_string(std::string str) {
-    for (auto it = str.rbegin(); it != str.rend(); ++it) {
-        switch (*it) {
-            case 'f': case 'F':
-                this->convert_binary_string(std::string("1111"));
-                break;
-            case 'e': case 'E':
-                this->convert_binary_string(std::string("1110"));
-                break;
-            case 'd': case 'D':
-                this->convert_binary_string(std::string("1101"));
-                break;
-            case 'c': case 'C':
-                this->convert_binary_string(std::string("1100"));
-                break;
-            case 'b': case 'B':
-                this->convert_binary_string(std::string("1011"));
-                break;
-            case 'a': case 'A':
-                this->convert_binary_string(std::string("1010"));
-                break;
-            case '9':
-                this->convert_binary_string(std::string("1001"));
-                break;
-            case '8':
-                this->convert_binary_string(std::string("1000"));
-                break;
-            case '7':
-                this->convert_binary_string(std::string("0111"));
-                break;
-            case '6':
-                this->convert_binary_string(std::string("0110"));
-                break;
-            case '5':
-                this->convert_binary_string(std::string("0101"));
-                break;
-            case '4':
-                this->convert_binary_string(std::string("0100"));
-                break;
-            case '3':
-                this->convert_binary_string(std::string("0011"));
-                break;
-            case '2':
-                this->convert_binary_string(std::string("0010"));
-                break;
-            case '1':
-                this->convert_binary_string(std::string("0001"));
-                break;
-            case '0':
-                this->convert_binary_string(std::string("0000"));
-                break;
-            default:
-                this->bits.clear();
-                return;
-        }
-    }
-}
-
-bool uInt::odd(char c) const {
-    return c == '1' || c == '3' || c == '5' || c == '7' || c == '9';
-}
-
-std::string uInt::div_by_2(std::string str) const {
-    std::string result;
-    uint8_t add = 0, new_digit;
-    for (auto it = str.begin(); it != str.end(); ++it) {
-        if ('0' > *it || *it > '9') {
-            throw std::runtime_error("ERROR: Cannot input non-decimal digits");
-        }
-        new_digit = (int(*it) - int('0')) / 2 + add;
-        result = result + char(new_digit + int('0'));
-        add = 5 * odd(*it);
-    }
-    if (result != std::string("0") && result[0] == '0') {
-        result = result.substr(1, result.size() - 1);
-    }
-    return result;
-}
-
-// https://stackoverflow.com/questions/11006844/convert-a-very-large-number-from-decimal-string-to-binary-representation
-void uInt::convert_decimal_string(std::string str) {
-    while (str != std::string("0") && str[0] == '0') {
-        str = str.substr(1, str.size() - 1);
-    }
-    if (str == std::string("0")) {
-        this->bits.clear();
-        return;
-    }
-    while (str != std::string("0")) {
-        this->bits.emplace_back(odd(*(str.rbegin())));
-        str = div_by_2(str);
-    }
-}
-
-// https://en.wikipedia.org/wiki/Karatsuba_algorithm#Pseudocode
-uInt uInt::karatsuba(const uInt& n) const {
-    if (this->bits.size() < KARATSUBA_BOUNDARY
-            || n.bits.size() < KARATSUBA_BOUNDARY) {
-        #ifdef PERFORMANCE_TEST
-            END_TEST(MUL_TIME)
-        #endif
-        return *this * n;
-    }
-    uInt h1, l1, h2, l2, z0, z1, z2, result;
-    uint64_t m = this->bits.size();
-    m = m < n.bits.size() ? m : n.bits.size();
-    uint64_t m2 = m >> 1;
-    h1.bits.insert(h1.bits.begin(), this->bits.begin() + m2, this->bits.end());
-    l1.bits.insert(l1.bits.begin(), this->bits.begin(), this->bits.begin() + m2);
-    h2.bits.insert(h2.bits.begin(), n.bits.begin() + m2, n.bits.end());
-    l2.bits.insert(l2.bits.begin(), n.bits.begin(), n.bits.begin() + m2);
-    z0 = l1.karatsuba(l2);
-    z1 = (l1 + h1).karatsuba(l2 + h2);
-    z2 = h1.karatsuba(h2);
-    result = (z2 << (m2 << 1)) + z0 + (z1 << m2);
-    result -= ((z2 + z0) << m2);
-    return result;
-}
-
-// ============================== Public Methods ==============================
-
-// =============================== Constructors ===============================
-
-uInt::uInt() : bits(std::vector<bool>()) {}
-
-uInt::uInt(const uint64_t& num)
-        : bits(std::vector<bool>()) {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(INT_TO_UINT_TIME)
-    #endif
-    uint64_t copy = num;
-    while (copy != 0) {
-        this->bits.emplace_back(copy & 1 ? true : false);
-        copy >>= 1;
-    }
-    this->remove_lead_zeros();
-    #ifdef PERFORMANCE_TEST
-        END_TEST(INT_TO_UINT_TIME)
-    #endif
-}
-
-uInt::uInt(const std::string& str)
-        : bits(std::vector<bool>()) {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(STRING_TO_UINT_TIME)
-    #endif
-    if (str.size() == 0) {
-        this->bits.clear();
-        return;
-    }
-    if (str.size() < 3) { // Decimal
-        this->convert_decimal_string(str);
-        this->remove_lead_zeros();
-        return;
-    }
-    std::string base = str.substr(0, 2);
-    if (base == std::string("0x") || base == std::string("0X")) {
-        this->convert_hex_string(str.substr(2, str.size() - 2));
-    } else if (base == std::string("0b") || base == std::string("0B")) {
-        this->convert_binary_string(str.substr(2, str.size() - 2));
-    } else {
-        this->convert_decimal_string(str);
-    }
-    this->remove_lead_zeros();
-    #ifdef PERFORMANCE_TEST
-        END_TEST(STRING_TO_UINT_TIME)
-    #endif
-}
-
-uInt::uInt(const uInt& n)
-        : bits(std::vector<bool>()) {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(COPY_TIME)
-    #endif
-    if (this != &n) {
-        this->bits.resize(n.bits.size(), false);
-        for (uint64_t i = 0; i < this->bits.size(); ++i)
-            this->bits[i] = n.bits[i];
-    }
-    #ifdef PERFORMANCE_TEST
-        END_TEST(COPY_TIME)
-    #endif
-}
-
-// ================================ To String =================================
-
-std::string uInt::to_string() const {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(UINT_TO_STRING_TIME)
-    #endif
-    if (this->bits.empty()) return std::string("0");
-    uInt n(*this), mod;
-    std::string result("");
-    while (n.bits.size()) {
-        std::pair<uInt, uInt> div_mod_result = n.div_and_mod(TEN);
-        mod = div_mod_result.second;
-        n = div_mod_result.first;
-        if (mod.bits.empty())
-            result = '0' + result;
-        else if (mod.bits.size() == 1)
-            result = '1' + result;
-        else if (mod == TWO)
-            result = '2' + result;
-        else if (mod == THREE)
-            result = '3' + result;
-        else if (mod == FOUR)
-            result = '4' + result;
-        else if (mod == FIVE)
-            result = '5' + result;
-        else if (mod == SIX)
-            result = '6' + result;
-        else if (mod == SEVEN)
-            result = '7' + result;
-        else if (mod == EIGHT)
-            result = '8' + result;
-        else if (mod == NINE)
-            result = '9' + result;
-        else {
-            throw std::runtime_error("ERROR: To String operation failed");
-        }
-    }
-    #ifdef PERFORMANCE_TEST
-        END_TEST(UINT_TO_STRING_TIME)
-    #endif
-    return result;
-}
-
-std::string uInt::to_string(const uint64_t& base) const {
-    if (*this == ZERO) return std::string("0");
-    std::string result_str("");
-    if (base == 2u) {
-        for (auto it = this->bits.rbegin(); it != this->bits.rend(); ++it) {
-            result_str.append(1, *it ? '1' : '0');
-        }
-        return result_str;
-    }
-    if (base == 10u) {
-        return this->to_string();
-    }
-    if (base == 64u) {
-        uInt uint_base(base), copy(*this), mod;
-        while (copy != ZERO) {
-            std::pair<uInt, uInt> div_mod_result = copy.div_and_mod(uint_base);
-            mod = div_mod_result.second;
-            copy = div_mod_result.first;
-            result_str = base64_index[uint64_t(mod)] + result_str;
-        }
-        return result_str;
-    }
-    if (base <= 36u) {
-        uInt uint_base(base), copy(*this), mod;
-        while (copy != ZERO) {
-            std::pair<uInt, uInt> div_mod_result = copy.div_and_mod(uint_base);
-            mod = div_mod_result.second;
-            copy = div_mod_result.first;
-            result_str = base_n_index[uint64_t(mod)] + result_str;
-        }
-        return result_str;
-    }
-    throw std::runtime_error("ERROR: Unaccepted base: " + base);
-}
-
-// ================================ Assignment ================================
-
-// ============================== Add and Assign ==============================
-uInt& uInt::operator+=(const uInt& n) {
-    #ifdef PERFORMANCE_TEST
-            START_TEST(ADD_TIME)
-        #endif
-        bool n1 = 0, n2 = 0, carry = 0;
-        if (this->bits.size() < n.bits.size()) {
-            this->bits.resize(n.bits.size(), false);
-        }
-        uint64_t i;
-        for (i = 0; i < n.bits.size(); ++i) {
-            n1 = this->bits[i];
-            n2 = n.bits[i];
-            this->bits[i] = carry != (n1 != n.bits[i]);
-            carry = (n1 && n2) || (n1 && carry) || (n2 && carry);
-        }
-        for (; i < this->bits.size(); ++i) {
-            n1 = this->bits[i];
-            this->bits[i] = carry != n1;
-            carry = n1 && carry;
-        }
-        if (carry)
-            this->bits.emplace_back(true);
-        #ifdef PERFORMANCE_TEST
-            END_TEST(ADD_TIME)
-        #endif
-        return *this; 
-}
-
-// ============================= Minus and Assign =============================
-uInt& uInt::operator-=(const uInt& n) {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(SUB_TIME)
-    #endif
-    if (*this <= n) {
-        this->bits.clear();
-        #ifdef PERFORMANCE_TEST
-            START_TEST(SUB_TIME)
-        #endif
-        return *this;
-    }
-    bool n1 = 0, n2 = 0;
-    uint64_t this_end = this->bits.size(), n_end = n.bits.size(), j;
-    for (uint64_t i = 0; i < n_end; ++i) {
-        n1 = this->bits[i];
-        n2 = n.bits[i];
-        this->bits[i] = n1 != n2;
-        if (n2 && !n1) {
-            for (j = i + 1; j < this_end; ++j) {
-                this->bits[j] = !this->bits[j];
-                if (!this->bits[j]) {
-                    break;
-                }
-            }
-            if (j == this_end) {
-                this->bits.clear();
-                #ifdef PERFORMANCE_TEST
-                    END_TEST(SUB_TIME)
-                #endif
-                return *this;
-            }
-        }
-    }
-    this->remove_lead_zeros();
-    #ifdef PERFORMANCE_TEST
-        END_TEST(SUB_TIME)
-    #endif
-    return *this;
-}
-
-// =========================== Multiply and Assign ============================
-uInt& uInt::operator*=(const uInt& n) {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(MUL_TIME)
-    #endif
-    if (this->bits.size() >= KARATSUBA_BOUNDARY && n.bits.size() >= KARATSUBA_BOUNDARY) {
-        *this = this->karatsuba(n);
-        #ifdef PERFORMANCE_TEST
-            END_TEST(MUL_TIME)
-        #endif
-        return *this;
-    }
-    uInt mult, shifted_n(n);
-    uint64_t end = this->bits.size();
-    for (uint64_t i = 0; i < end; ++i) {
-        if (this->bits[i]) mult += shifted_n;
-        shifted_n <<= 1;
-    }
-    this->bits = mult.bits;
-    #ifdef PERFORMANCE_TEST
-        END_TEST(MUL_TIME)
-    #endif
-    return *this;
-}
-
-// ============================ Divide and Assign =============================
-uInt& uInt::operator/=(const uInt& n) {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(DIV_TIME)
-    #endif
-    if (n == 0) {
-        throw std::runtime_error("ERROR: Divide by 0 Exception");
-    }
-    if (this->bits.size() == 0) {
-        #ifdef PERFORMANCE_TEST
-            START_TEST(DIV_TIME)
-        #endif
-        return *this;
-    }
-    uInt curr(0);
-    for (uint64_t i = this->bits.size() - 1; i != negative_one; --i) {
-        curr <<= 1;
-        if (this->bits[i]) ++curr;
-        if (curr >= n) {
-            this->bits[i] = true;
-            curr -= n;
-        } else {
-            this->bits[i] = false;
-        }
-    }
-    this->remove_lead_zeros();
-    #ifdef PERFORMANCE_TEST
-        END_TEST(DIV_TIME)
-    #endif
-    return *this;
-}
-
-// ============================== Mod and Assign ==============================
-uInt& uInt::operator%=(const uInt& n) {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(MOD_TIME)
-    #endif
-    uInt curr(0);
-    for (uint64_t i = this->bits.size() - 1; i != negative_one; --i) {
-        curr <<= 1;
-        if (this->bits[i]) ++curr;
-        if (curr >= n) {
-            curr -= n;
-        }
-    }
-    this->bits = curr.bits;
-    this->remove_lead_zeros();
-    #ifdef PERFORMANCE_TEST
-        END_TEST(MOD_TIME)
-    #endif
-    return *this;
-}
-
-// ========================== Shift Left and Assign ===========================
-uInt& uInt::operator<<=(const uint64_t& pos) {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(SL_TIME)
-    #endif
-    if (this->bits.size() == 0 || pos == 0) return *this;
-    this->bits.insert(this->bits.begin(), pos, false);
-    #ifdef PERFORMANCE_TEST
-        END_TEST(SL_TIME)
-    #endif
-    return *this;
-}
-
-// ========================== Shift Right and Assign ==========================
-uInt& uInt::operator>>=(const uint64_t& pos) {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(SR_TIME)
-    #endif
-    if (this->bits.size() == 0 || pos == 0) return *this;
-    this->bits.erase(this->bits.begin(), this->bits.begin() + pos);
-    #ifdef PERFORMANCE_TEST
-        END_TEST(SR_TIME)
-    #endif
-    return *this;
-}
-
-// ========================== Bitwise AND and Assign ==========================
-uInt& uInt::operator&=(const uInt& n) {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(AND_TIME)
-    #endif
-    if (this->bits.size() > n.bits.size())
-        this->bits.resize(n.bits.size(), false);
-    uint64_t end = this->bits.size();
-    for (uint64_t i = 0; i < end; ++i) {
-        this->bits[i] = this->bits[i] && n.bits[i];
-    }
-    this->remove_lead_zeros();
-    #ifdef PERFORMANCE_TEST
-        END_TEST(AND_TIME)
-    #endif
-    return *this;
-}
-
-// ========================== Bitwise OR and Assign ===========================
-uInt& uInt::operator|=(const uInt& n) {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(OR_TIME)
-    #endif
-    if (this->bits.size() < n.bits.size())
-        this->bits.resize(n.bits.size(), false);
-    uint64_t end = n.bits.size();
-    for (uint64_t i = 0; i < end; ++i) {
-        this->bits[i] = this->bits[i] || n.bits[i];
-    }
-    this->remove_lead_zeros();
-    #ifdef PERFORMANCE_TEST
-        END_TEST(OR_TIME)
-    #endif
-    return *this;
-}
-
-// ========================== Bitwise XOR and Assign ==========================
-uInt& uInt::operator^=(const uInt& n) {
-    #ifdef PERFORMANCE_TEST
-            START_TEST(XOR_TIME)
-        #endif
-        if (this->bits.size() < n.bits.size())
-            this->bits.resize(n.bits.size(), false);
-        uint64_t end = n.bits.size();
-        for (uint64_t i = 0; i < end; ++i) {
-            this->bits[i] = this->bits[i] ^ n.bits[i];
-        }
-        this->remove_lead_zeros();
-        #ifdef PERFORMANCE_TEST
-            END_TEST(XOR_TIME)
-        #endif
-        return *this;
-}
-
-// ================================ Arithmetic ================================
-
-uInt& uInt::operator+(const uInt& n) const {
-    uInt* sum = new uInt(*this);
-    *sum += n;
-    return *sum;
-}
-
-uInt& uInt::operator-(const uInt& n) const {
-    uInt* difference = new uInt(*this);
-    *difference -= n;
-    return *difference;
-}
-
-uInt& uInt::operator*(const uInt& n) const {
-    uInt* product = new uInt(*this);
-    *product *= n;
-    return *product;
-}
+// =========================== Non-Class Functions ============================
 
-uInt& uInt::operator/(const uInt& n) const {
-    uInt* quotient = new uInt(*this);
-    *quotient /= n;
-    return *quotient;
-}
+std::ostream& operator<<(std::ostream&, const uInt&);
+std::istream& operator>>(std::istream&, uInt&);
+uInt operator+(const uint64_t&, const uInt&);
+uInt operator-(const uint64_t&, const uInt&);
+uInt operator*(const uint64_t&, const uInt&);
+uInt operator/(const uint64_t&, const uInt&);
+uInt operator%(const uint64_t&, const uInt&);
+uInt& operator&(const uint64_t&, const uInt&);
+uInt& operator|(const uint64_t&, const uInt&);
+uInt& operator^(const uint64_t&, const uInt&);
+int compare(const uInt_view&, const uInt_view&);
+bool operator==(const uInt_view&, const uInt_view&);
+bool operator!=(const uInt_view&, const uInt_view&);
+bool operator<(const uInt_view&, const uInt_view&);
+bool operator>(const uInt_view&, const uInt_view&);
+bool operator<=(const uInt_view&, const uInt_view&);
+bool operator>=(const uInt_view&, const uInt_view&);
+void import_bits(uInt&, const uint64_t&, const int&, const uint64_t&,
+    const int&, const uint64_t&, const void*);
+uint64_t export_count(const uInt&, const uint64_t&, const uint64_t&);
+uint64_t export_bits(void*, const int&, const uint64_t&, const int&,
+    const uint64_t&, const uInt&);
 
-uInt& uInt::operator%(const uInt& n) const {
-    uInt* mod = new uInt(*this);
-    *mod %= n;
-    return *mod;
-}
+// ============================= Helper Variables =============================
 
-uInt& uInt::operator<<(const uint64_t& pos) const {
-    uInt* lsh = new uInt(*this);
-    *lsh <<= pos;
-    return *lsh;
-}
+// The helper variables and constants are inline so every translation unit
+// which includes this header shares one definition of each, and the digit
+// tables are constant initialized.
 
-uInt& uInt::operator>>(const uint64_t& pos) const {
-    uInt* rsh = new uInt(*this);
-    *rsh >>= pos;
-    return *rsh;
-}
+inline constexpr uint64_t negative_one = uint64_t(-1);
 
-uInt& uInt::operator&(const uInt& n) const {
-    uInt* and_result = new uInt(*this);
-    *and_result &= n;
-    return *and_result;
-}
+inline constexpr char base64_index[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+inline constexpr char base_n_index[] = "0123456789abcdefghijklmnopqrstuvwxyz";
 
-uInt& uInt::operator|(const uInt& n) const {
-    uInt* or_result = new uInt(*this);
-    *or_result |= n;
-    return *or_result;
+#ifdef WORD_ACCESS
+// Returns the words behind a non-empty bit_vector. Bits past size() in the
+// last word are unspecified.
+inline uint64_t* bit_words(bit_vector& bits) {
+    return reinterpret_cast<uint64_t*>(bits.begin()._M_p);
 }
 
-uInt& uInt::operator^(const uInt& n) const {
-    uInt* xor_result = new uInt(*this);
-    *xor_result ^= n;
-    return *xor_result;
+inline const uint64_t* bit_words(const bit_vector& bits) {
+    return reinterpret_cast<const uint64_t*>(bits.begin()._M_p);
 }
 
-// ================================ Unary =================================
-
-uInt& uInt::operator++() {
-    return *this += ONE;
-}
-
-uInt& uInt::operator--() {
-    return *this -= ONE;
-}
-
-// ============================= Conditional ==============================
-
-bool uInt::operator==(const uInt& n) const {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(EQ_TIME)
-    #endif
-    if (this->bits.size() != n.bits.size()) {
-        #ifdef PERFORMANCE_TEST
-            END_TEST(EQ_TIME)
-        #endif
-        return false;
-    }
-    uint64_t end = this->bits.size();
-    for (uint64_t i = 0; i < end; ++i) {
-        if (this->bits[i] != n.bits[i]) {
-            #ifdef PERFORMANCE_TEST
-                END_TEST(EQ_TIME)
-            #endif
-            return false;
-        }
-    }
-    #ifdef PERFORMANCE_TEST
-        END_TEST(EQ_TIME)
-    #endif
-    return true;
-}
-
-bool uInt::operator!=(const uInt& n) const {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(NEQ_TIME)
-    #endif
-    if (this->bits.size() != n.bits.size()) {
-        #ifdef PERFORMANCE_TEST
-            END_TEST(NEQ_TIME)
-        #endif
-        return true;
-    }
-    uint64_t end = this->bits.size();
-    for (uint64_t i = 0; i < end; ++i) {
-        if (this->bits[i] != n.bits[i]) {
-            #ifdef PERFORMANCE_TEST
-                END_TEST(NEQ_TIME)
-            #endif
-            return true;
-        }
-    }
-    #ifdef PERFORMANCE_TEST
-        END_TEST(NEQ_TIME)
-    #endif
-    return false;
-}
-
-bool uInt::operator<(const uInt& n) const {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(LT_TIME)
-    #endif
-    if (this->bits.size() < n.bits.size()) {
-        #ifdef PERFORMANCE_TEST
-            END_TEST(LT_TIME)
-        #endif
-        return true;
-    }
-    if (this->bits.size() > n.bits.size()) {
-        #ifdef PERFORMANCE_TEST
-            END_TEST(LT_TIME)
-        #endif
-        return false;
-    }
-    for (uint64_t i = this->bits.size() - 1; i != negative_one; --i) {
-        if (this->bits[i] != n.bits[i]) {
-            #ifdef PERFORMANCE_TEST
-                END_TEST(LT_TIME)
-            #endif
-            return n.bits[i];
-        }
-    }
-    #ifdef PERFORMANCE_TEST
-        END_TEST(LT_TIME)
-    #endif
-    return false;
-}
-
-bool uInt::operator>(const uInt& n) const {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(GT_TIME)
-    #endif
-    if (this->bits.size() > n.bits.size()) {
-        #ifdef PERFORMANCE_TEST
-            END_TEST(GT_TIME)
-        #endif
-        return true;
-    }
-    if (this->bits.size() < n.bits.size()) {
-        #ifdef PERFORMANCE_TEST
-            END_TEST(GT_TIME)
-        #endif
-        return false;
-    }
-    for (uint64_t i = this->bits.size() - 1; i != negative_one; --i) {
-        if (this->bits[i] != n.bits[i]) {
-            #ifdef PERFORMANCE_TEST
-                END_TEST(GT_TIME)
-            #endif
-            return this->bits[i];
-        }
-    }
-    #ifdef PERFORMANCE_TEST
-        END_TEST(GT_TIME)
-    #endif
-    return false;
+// Returns word i of a non-empty bit_vector with the bits past size() cleared.
+inline uint64_t masked_word(const bit_vector& bits, const uint64_t& i) {
+    uint64_t word = bit_words(bits)[i];
+    if (i == (bits.size() - 1) >> 6 && (bits.size() & 63))
+        word &= (uint64_t(1) << (bits.size() & 63)) - 1;
+    return word;
 }
+#endif
 
-bool uInt::operator<=(const uInt& n) const {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(LTE_TIME)
-    #endif
-    if (this->bits.size() < n.bits.size()) {
-        #ifdef PERFORMANCE_TEST
-            END_TEST(LTE_TIME)
-        #endif
-        return true;
-    }
-    if (this->bits.size() > n.bits.size()) {
-        #ifdef PERFORMANCE_TEST
-            END_TEST(LTE_TIME)
-        #endif
-        return false;
-    }
-    for (uint64_t i = this->bits.size() - 1; i != negative_one; --i) {
-        if (this->bits[i] != n.bits[i]) {
-            #ifdef PERFORMANCE_TEST
-                END_TEST(LTE_TIME)
-            #endif
-            return n.bits[i];
-        }
-    }
-    #ifdef PERFORMANCE_TEST
-        END_TEST(LTE_TIME)
-    #endif
-    return true;
-}
+inline const uInt ZERO = uInt(0);
+inline const uInt ONE = uInt(1);
+inline const uInt TWO = uInt(2);
+inline const uInt THREE = uInt(3);
+inline const uInt FOUR = uInt(4);
+inline const uInt FIVE = uInt(5);
+inline const uInt SIX = uInt(6);
+inline const uInt SEVEN = uInt(7);
+inline const uInt EIGHT = uInt(8);
+inline const uInt NINE = uInt(9);
+inline const uInt TEN = uInt(10);
+
+
+// ============================== Combinatorics ===============================
+
+std::vector<uint64_t> primes_up_to(const uint64_t&);
+uInt factorial(const uint64_t&);
+uInt binomial(const uint64_t&, uint64_t);
+
+// ============================ Linear Recurrences =============================
+
+uInt fibonacci(const uint64_t&);
+uInt lucas(const uint64_t&);
+uInt linear_recurrence(const std::vector<uInt>&, const std::vector<uInt>&,
+    const uint64_t&);
+
+// =============================== Word Kernels ===============================
+
+// The routines below work on std::vector<uint64_t> values stored least
+// significant word first with no zero words on top, so that an empty vector is
+// zero. Algorithms which make many passes over their operands convert to words
+// once, do all of their work here and convert back at the end.
+
+std::vector<uint64_t> to_words(const uInt&);
+uInt from_words(const std::vector<uint64_t>&);
+void words_normalize(std::vector<uint64_t>&);
+uint64_t words_bit_length(const std::vector<uint64_t>&);
+uint64_t words_count_trailing_zeros(const std::vector<uint64_t>&);
+int words_compare(const std::vector<uint64_t>&, const std::vector<uint64_t>&);
+void words_add(std::vector<uint64_t>&, const std::vector<uint64_t>&);
+void words_sub(std::vector<uint64_t>&, const std::vector<uint64_t>&);
+std::vector<uint64_t> words_mul_word(const std::vector<uint64_t>&, const uint64_t&);
+uint64_t words_mul_scratch(const uint64_t&, const uint64_t&);
+void words_mul_into(const uint64_t*, const uint64_t&, const uint64_t*,
+    const uint64_t&, uint64_t*, uint64_t*);
+std::vector<uint64_t> words_mul(const std::vector<uint64_t>&, const std::vector<uint64_t>&);
+void words_sqr(const std::vector<uint64_t>&, std::vector<uint64_t>&);
+void words_add_mul(std::vector<uint64_t>&, const std::vector<uint64_t>&,
+    const std::vector<uint64_t>&);
+void words_shift_right(std::vector<uint64_t>&, const uint64_t&);
+void words_shift_left(std::vector<uint64_t>&, const uint64_t&);
+uint64_t words_window(const std::vector<uint64_t>&, const uint64_t&);
+void words_div_mod(const std::vector<uint64_t>&, const std::vector<uint64_t>&,
+    std::vector<uint64_t>&, std::vector<uint64_t>&);
+std::vector<uint64_t> words_product(std::vector<std::vector<uint64_t>>&);
+
+// =============================== Product Trees ==============================
+
+// Multiplies every value in [begin, end), either atn::uInt values or words,
+// using a balanced product tree on word vectors. An empty range has a product
+// of one.
+template <typename Iterator>
+uInt product(Iterator begin, Iterator end) {
+    std::vector<std::vector<uint64_t>> level;
+    for (; begin != end; ++begin) {
+        const uInt& value = *begin;
+        level.emplace_back(to_words(value));
+    }
+    return from_words(words_product(level));
+}
+
+// ================================= Literals =================================
+
+// The words of an integer literal, parsed at compile time. A literal has at
+// most four bits per character, so Words is always enough.
+template <uint64_t Words>
+struct literal_words {
+    uint64_t words[Words] = {};
+};
 
-bool uInt::operator>=(const uInt& n) const {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(GTE_TIME)
-    #endif
-    if (this->bits.size() > n.bits.size()) {
-        #ifdef PERFORMANCE_TEST
-            END_TEST(GTE_TIME)
-        #endif
-        return true;
-    }
-    if (this->bits.size() < n.bits.size()) {
-        #ifdef PERFORMANCE_TEST
-            END_TEST(GTE_TIME)
-        #endif
-        return false;
-    }
-    for (uint64_t i = this->bits.size() - 1; i != negative_one; --i) {
-        if (this->bits[i] != n.bits[i]) {
-            #ifdef PERFORMANCE_TEST
-                END_TEST(GTE_TIME)
-            #endif
-            return this->bits[i];
+// Parses the characters of a decimal, hexadecimal (0x), binary (0b) or octal
+// (leading 0) literal, skipping digit separators. The compiler has already
+// rejected any digit which is not valid for the literal's base.
+template <uint64_t Words, uint64_t Length>
+constexpr literal_words<Words> parse_literal(const char (&digits)[Length]) {
+    literal_words<Words> value;
+    uint64_t base = 10, start = 0;
+    if (Length > 1 && digits[0] == '0') {
+        if (digits[1] == 'x' || digits[1] == 'X') base = 16, start = 2;
+        else if (digits[1] == 'b' || digits[1] == 'B') base = 2, start = 2;
+        else base = 8, start = 1;
+    }
+    for (uint64_t i = start; i < Length; ++i) {
+        char c = digits[i];
+        if (c == '\'') continue;
+        unsigned __int128 carry = '0' <= c && c <= '9' ? c - '0'
+            : 'a' <= c && c <= 'f' ? c - 'a' + 10 : c - 'A' + 10;
+        for (uint64_t w = 0; w < Words; ++w) {
+            carry += (unsigned __int128)value.words[w] * base;
+            value.words[w] = uint64_t(carry);
+            carry >>= 64;
         }
     }
-    #ifdef PERFORMANCE_TEST
-        END_TEST(GTE_TIME)
-    #endif
-    return true;
+    return value;
 }
 
-// =============================== Casting ================================
+inline namespace literals {
 
-uInt::operator uint64_t() const {
-    #ifdef PERFORMANCE_TEST
-        START_TEST(UINT_TO_INT_TIME)
-    #endif
-    uint64_t result = std::accumulate(this->bits.rbegin(), this->bits.rend(), 0ull, [](uint64_t x, bool y) { return (x << 1) + y; });
-    #ifdef PERFORMANCE_TEST
-        END_TEST(UINT_TO_INT_TIME)
-    #endif
-    return result;
+// 123456789012345678901234567890_u is parsed into static storage by the
+// compiler, so at run time it only costs copying its words into a uInt.
+template <char... Digits>
+uInt operator""_u() {
+    static constexpr char digits[] = { Digits... };
+    static constexpr uint64_t words = ((sizeof...(Digits) << 2) + 63) >> 6;
+    static constexpr literal_words<words> value = parse_literal<words>(digits);
+    return from_words(std::vector<uint64_t>(value.words, value.words + words));
 }
 
-// =========================== Non-Class Functions ============================
+} // End namespace literals
 
-std::ostream& operator<<(std::ostream& out, const uInt& n) {
-    out << n.to_string();
-    return out;
-}
+// =============================== Number Theory ==============================
 
-uInt& operator+(const uint64_t& num, const uInt& n) {
-    return n + num;
-}
-
-uInt& operator-(const uint64_t& num, const uInt& n) {
-    return uInt(num) - n;
-}
-
-uInt& operator*(const uint64_t& num, const uInt& n) {
-    return n * num;
-}
-
-uInt& operator/(const uint64_t& num, const uInt& n) {
-    return uInt(num) / n;
-}
+// The result of gcdext, a * x + b * y = gcd. The cofactors are stored as
+// magnitudes with their signs held separately.
+struct gcdext_result {
+    uInt gcd;
+    uInt x;
+    bool x_negative;
+    uInt y;
+    bool y_negative;
+};
 
-uInt& operator%(const uint64_t& num, const uInt& n) {
-    return uInt(num) % n;
-}
+uInt gcd(const uInt&, const uInt&);
+gcdext_result gcdext(const uInt&, const uInt&);
+uInt lcm(const uInt&, const uInt&);
+uInt invert_mod(const uInt&, const uInt&);
+uInt pow(const uInt&, const uint64_t&);
+uInt iroot(const uInt&, const uint64_t&);
+std::pair<uInt, uInt> rootrem(const uInt&, const uint64_t&);
+uInt isqrt(const uInt&);
+std::pair<uInt, uInt> sqrtrem(const uInt&);
 
-uInt& operator&(const uint64_t& num, const uInt& n) {
-    return n & num;
-}
+// ================================ Primality =================================
 
-uInt& operator|(const uint64_t& num, const uInt& n) {
-    return n | num;
-}
+bool is_probable_prime(const uInt&, const uint64_t& = 0);
+uInt next_prime(const uInt&);
+std::vector<bool> probable_primes(const std::vector<uInt>&, const uint64_t& = 0,
+    uint64_t = 0);
 
-uInt& operator^(const uint64_t& num, const uInt& n) {
-    return n ^ num;
-}
 // =========================== Performance Testing ============================
 
 #ifdef PERFORMANCE_TEST
-void print_performance_test_results() {
-    double total = 0.0;
-    for (auto time : durations) {
-        total += time.count();
-    }
-    std::cout << std::endl << "PERFORMANCE TEST RESULTS" << std::endl;
-    std::cout << "======================================================" << std::endl;
-    for (uint64_t i = 0; i < NUM_OF_TESTS; ++i) {
-        double time = durations[i].count();
-        std::cout << std::setw(27);
-        switch (i) {
-            case REMOVE_LEAD_ZEROS_TIME:
-                std::cout << "REMOVE_LEAD_ZEROS";
-                break;
-            case INT_TO_UINT_TIME:
-                std::cout << "INT TO UINT";
-                break;
-            case STRING_TO_UINT_TIME:
-                std::cout << "STRING TO UINT";
-                break;
-            case COPY_TIME:
-                std::cout << "COPY";
-                break;
-            case ADD_TIME:
-                std::cout << "ADDITION";
-                break;
-            case SUB_TIME:
-                std::cout << "SUBTRACTION";
-                break;
-            case MUL_TIME:
-                std::cout << "MULTIPLICATION";
-                break;
-            case DIV_TIME:
-                std::cout << "DIVISION";
-                break;
-            case MOD_TIME:
-                std::cout << "MODULO";
-                break;
-            case SL_TIME:
-                std::cout << "SHIFT LEFT";
-                break;
-            case SR_TIME:
-                std::cout << "SHIFT RIGHT";
-                break;
-            case AND_TIME:
-                std::cout << "BITWISE AND";
-                break;
-            case OR_TIME:
-                std::cout << "BITWISE OR";
-                break;
-            case XOR_TIME:
-                std::cout << "BITWISE XOR";
-                break;
-            case EQ_TIME:
-                std::cout << "EQUALS";
-                break;
-            case NEQ_TIME:
-                std::cout << "NOT EQUALS";
-                break;
-            case LT_TIME:
-                std::cout << "LESS THAN";
-                break;
-            case GT_TIME:
-                std::cout << "GREATER THAN";
-                break;
-            case LTE_TIME:
-                std::cout << "GREATER THAN OR EQUAL TO";
-                break;
-            case GTE_TIME:
-                std::cout << "LESS THAN OR EQUAL TO";
-                break;
-            case UINT_TO_INT_TIME:
-                std::cout << "UINT TO INT";
-                break;
-            case UINT_TO_STRING_TIME:
-                std::cout << "UINT TO STRING";
-                break;
-            default:
-                std::cout << "";
-        }
-        std::cout << " || " << std::setw(8) << time << "ms, " << (time / total * 100) << "%" << std::endl;
-    }
-}
+#ifdef HARDWARE_COUNTERS
+bool hardware_counter_opened(const uint64_t&);
+#endif
+std::vector<operation_totals> merge_performance_counters();
+
+#ifdef MEMORY_ACCOUNTING
+// Allocations of uInt storage over the whole process, including those made
+// outside of any instrumented operation.
+struct memory_usage {
+    uint64_t allocations;
+    uint64_t allocated_bytes;
+    uint64_t freed_bytes;
+    int64_t live_bytes;
+    int64_t peak_bytes;
+};
+memory_usage process_memory_usage();
+#endif
+std::string performance_test_json();
+void print_performance_test_results();
 #endif
 
 } // End namespace atn
 
-#endif // _UINTEGER_UINT_HPP_
\ No newline at end of file
+#endif // _UINTEGER_UINT_HPP_
@@ -0,0 +1,474 @@
+// Written by Aaron Barge
+// Copyright 2020
+
+// The word kernels declared in uInt.hpp. They are kept in their own
+// translation unit so they can be compiled with different flags from the rest
+// of the library, e.g. for a particular instruction set or with profile data.
+
+#include "uInt.hpp"
+#include <algorithm> // std::copy, std::fill
+
+// Factors shorter than this many words are multiplied with the schoolbook
+// method.
+#define KARATSUBA_WORDS 32
+
+namespace atn { // AaronTheNerd
+
+// =============================== Word Kernels ===============================
+
+// The routines below work on std::vector<uint64_t> values stored least
+// significant word first with no zero words on top, so that an empty vector is
+// zero. Algorithms which make many passes over their operands convert to words
+// once, do all of their work here and convert back at the end.
+
+std::vector<uint64_t> to_words(const uInt& n) {
+    std::vector<uint64_t> words((n.bits.size() + 63) >> 6, 0);
+    #ifdef WORD_ACCESS
+        for (uint64_t i = 0; i < words.size(); ++i)
+            words[i] = masked_word(n.bits, i);
+    #else
+        for (uint64_t i = 0; i < n.bits.size(); ++i) {
+            if (n.bits[i]) words[i >> 6] |= uint64_t(1) << (i & 63);
+        }
+    #endif
+    return words;
+}
+
+uInt from_words(const std::vector<uint64_t>& words) {
+    uInt n;
+    uint64_t size = words.size();
+    while (size != 0 && words[size - 1] == 0)
+        --size;
+    if (size == 0) return n;
+    n.bits.resize((size << 6) - __builtin_clzll(words[size - 1]));
+    #ifdef WORD_ACCESS
+        uint64_t* out = bit_words(n.bits);
+        for (uint64_t i = 0; i < size; ++i)
+            out[i] = words[i];
+    #else
+        for (uint64_t i = 0; i < n.bits.size(); ++i)
+            n.bits[i] = (words[i >> 6] >> (i & 63)) & 1;
+    #endif
+    return n;
+}
+
+void words_normalize(std::vector<uint64_t>& a) {
+    while (!a.empty() && a.back() == 0)
+        a.pop_back();
+}
+
+uint64_t words_bit_length(const std::vector<uint64_t>& a) {
+    return a.empty() ? 0 : (a.size() << 6) - __builtin_clzll(a.back());
+}
+
+uint64_t words_count_trailing_zeros(const std::vector<uint64_t>& a) {
+    uint64_t i = 0;
+    while (a[i] == 0)
+        ++i;
+    return (i << 6) + __builtin_ctzll(a[i]);
+}
+
+// Returns a negative value, zero or a positive value when a is less than,
+// equal to or greater than b.
+int words_compare(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+    for (uint64_t i = a.size() - 1; i != negative_one; --i) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+void words_add(std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    if (a.size() < b.size()) a.resize(b.size(), 0);
+    unsigned __int128 carry = 0;
+    for (uint64_t i = 0; i < a.size() && (i < b.size() || carry != 0); ++i) {
+        carry += (unsigned __int128)a[i] + (i < b.size() ? b[i] : 0);
+        a[i] = uint64_t(carry);
+        carry >>= 64;
+    }
+    if (carry != 0) a.emplace_back(1);
+}
+
+// Requires a >= b.
+void words_sub(std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    uint64_t borrow = 0;
+    for (uint64_t i = 0; i < a.size() && (i < b.size() || borrow != 0); ++i) {
+        uint64_t subtrahend = i < b.size() ? b[i] : 0;
+        uint64_t difference = a[i] - subtrahend - borrow;
+        borrow = a[i] < subtrahend || (a[i] == subtrahend && borrow);
+        a[i] = difference;
+    }
+    words_normalize(a);
+}
+
+std::vector<uint64_t> words_mul_word(const std::vector<uint64_t>& a, const uint64_t& w) {
+    std::vector<uint64_t> result;
+    if (a.empty() || w == 0) return result;
+    result.resize(a.size() + 1);
+    unsigned __int128 carry = 0;
+    for (uint64_t i = 0; i < a.size(); ++i) {
+        carry += (unsigned __int128)a[i] * w;
+        result[i] = uint64_t(carry);
+        carry >>= 64;
+    }
+    result[a.size()] = uint64_t(carry);
+    words_normalize(result);
+    return result;
+}
+
+namespace { // File local helpers
+
+// Writes the n + m words of a * b to out, one row per word of a.
+void words_mul_basecase(const uint64_t* a, const uint64_t& n, const uint64_t* b,
+        const uint64_t& m, uint64_t* out) {
+    std::fill(out, out + n + m, 0);
+    for (uint64_t i = 0; i < n; ++i) {
+        if (a[i] == 0) continue;
+        unsigned __int128 carry = 0;
+        for (uint64_t j = 0; j < m; ++j) {
+            carry += (unsigned __int128)a[i] * b[j] + out[i + j];
+            out[i + j] = uint64_t(carry);
+            carry >>= 64;
+        }
+        out[i + m] = uint64_t(carry);
+    }
+}
+
+// Writes the 2n words of a^2 to out. Each cross product a[i]a[j] with i < j
+// is computed once and the sum is doubled with a one bit shift before the
+// squares a[i]^2 are added on the diagonal, so squaring takes about half the
+// multiplications of words_mul_basecase.
+void words_sqr_basecase(const uint64_t* a, const uint64_t& n, uint64_t* out) {
+    std::fill(out, out + (n << 1), 0);
+    for (uint64_t i = 0; i < n; ++i) {
+        unsigned __int128 carry = 0;
+        for (uint64_t j = i + 1; j < n; ++j) {
+            carry += (unsigned __int128)a[i] * a[j] + out[i + j];
+            out[i + j] = uint64_t(carry);
+            carry >>= 64;
+        }
+        out[i + n] = uint64_t(carry);
+    }
+    uint64_t top = 0;
+    for (uint64_t i = 0; i < (n << 1); ++i) {
+        uint64_t next = out[i] >> 63;
+        out[i] = (out[i] << 1) | top;
+        top = next;
+    }
+    unsigned __int128 carry = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+        carry += (unsigned __int128)a[i] * a[i] + out[i << 1];
+        out[i << 1] = uint64_t(carry);
+        carry = (carry >> 64) + out[(i << 1) + 1];
+        out[(i << 1) + 1] = uint64_t(carry);
+        carry >>= 64;
+    }
+}
+
+// Adds the n words at b into the words at a and carries as far as needed.
+// The caller makes sure the sum fits.
+void words_add_at(uint64_t* a, const uint64_t* b, const uint64_t& n) {
+    unsigned __int128 carry = 0;
+    uint64_t i = 0;
+    for (; i < n; ++i) {
+        carry += (unsigned __int128)a[i] + b[i];
+        a[i] = uint64_t(carry);
+        carry >>= 64;
+    }
+    for (; carry != 0; ++i) {
+        carry += a[i];
+        a[i] = uint64_t(carry);
+        carry >>= 64;
+    }
+}
+
+// Subtracts the n words at b from the words at a, which must not be smaller.
+void words_sub_at(uint64_t* a, const uint64_t* b, const uint64_t& n) {
+    bool borrow = false;
+    uint64_t i = 0;
+    for (; i < n; ++i) {
+        uint64_t difference = a[i] - b[i];
+        bool next = a[i] < b[i] || difference < uint64_t(borrow);
+        a[i] = difference - borrow;
+        borrow = next;
+    }
+    for (; borrow; ++i)
+        borrow = a[i]-- == 0;
+}
+
+// Scratch words needed by words_karatsuba for n word factors: the two sums
+// of halves and their product, plus whatever that product needs.
+uint64_t words_karatsuba_scratch(const uint64_t& n) {
+    if (n < KARATSUBA_WORDS) return 0;
+    uint64_t k = n - (n >> 1) + 1;
+    return 4 * k + words_karatsuba_scratch(k);
+}
+
+// Writes the 2n words of a * b to out for two n word factors. When a and b
+// are the same words every product below is a square, and only one sum of
+// halves is formed.
+void words_karatsuba(const uint64_t* a, const uint64_t* b, const uint64_t& n,
+        uint64_t* out, uint64_t* scratch) {
+    if (n < KARATSUBA_WORDS) {
+        if (a == b) {
+            words_sqr_basecase(a, n, out);
+        } else {
+            words_mul_basecase(a, n, b, n, out);
+        }
+        return;
+    }
+    uint64_t h = n >> 1, k = n - h + 1;
+    uint64_t* a_sum = scratch;
+    uint64_t* b_sum = a == b ? a_sum : scratch + k;
+    uint64_t* middle = scratch + 2 * k;
+    words_karatsuba(a, b, h, out, scratch);
+    words_karatsuba(a + h, b + h, n - h, out + 2 * h, scratch);
+    std::copy(a + h, a + n, a_sum);
+    a_sum[k - 1] = 0;
+    words_add_at(a_sum, a, h);
+    if (a != b) {
+        std::copy(b + h, b + n, b_sum);
+        b_sum[k - 1] = 0;
+        words_add_at(b_sum, b, h);
+    }
+    words_karatsuba(a_sum, b_sum, k, middle, scratch + 4 * k);
+    words_sub_at(middle, out, 2 * h);
+    words_sub_at(middle, out + 2 * h, 2 * (n - h));
+    words_add_at(out + h, middle, 2 * k);
+}
+
+} // End anonymous namespace
+
+// Scratch words needed by words_mul_into for factors of n >= m words.
+uint64_t words_mul_scratch(const uint64_t& n, const uint64_t& m) {
+    if (m < KARATSUBA_WORDS) return 0;
+    uint64_t need = words_karatsuba_scratch(m);
+    if (n % m != 0) {
+        uint64_t nested = words_mul_scratch(m, n % m);
+        if (nested > need) need = nested;
+    }
+    return 2 * m + need;
+}
+
+// Writes the n + m words of a * b to out for n >= m > 0, with
+// words_mul_scratch(n, m) words of scratch. Factors of KARATSUBA_WORDS or
+// more use Karatsuba's method. The longer factor is cut into pieces as long
+// as the shorter one, and each balanced product is added in at its offset.
+// It works on plain pointers so mapped_uInt can run it on mapped files.
+void words_mul_into(const uint64_t* a, const uint64_t& n, const uint64_t* b,
+        const uint64_t& m, uint64_t* out, uint64_t* scratch) {
+    if (m < KARATSUBA_WORDS) {
+        words_mul_basecase(a, n, b, m, out);
+        return;
+    }
+    if (a == b && n == m) {
+        words_karatsuba(a, a, n, out, scratch);
+        return;
+    }
+    std::fill(out, out + n + m, 0);
+    uint64_t* piece = scratch;
+    for (uint64_t i = 0; i < n; i += m) {
+        uint64_t length = n - i < m ? n - i : m;
+        if (length == m) {
+            words_karatsuba(a + i, b, m, piece, scratch + 2 * m);
+        } else {
+            words_mul_into(b, m, a + i, length, piece, scratch + 2 * m);
+        }
+        words_add_at(out + i, piece, length + m);
+    }
+}
+
+std::vector<uint64_t> words_mul(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    std::vector<uint64_t> result;
+    if (a.empty() || b.empty()) return result;
+    const std::vector<uint64_t>& longer = a.size() >= b.size() ? a : b;
+    const std::vector<uint64_t>& shorter = a.size() >= b.size() ? b : a;
+    std::vector<uint64_t> scratch(words_mul_scratch(longer.size(), shorter.size()));
+    result.resize(a.size() + b.size());
+    words_mul_into(longer.data(), longer.size(), shorter.data(), shorter.size(),
+        result.data(), scratch.data());
+    words_normalize(result);
+    return result;
+}
+
+// Sets result, which must not be a, to a^2. result keeps its capacity
+// between calls.
+void words_sqr(const std::vector<uint64_t>& a, std::vector<uint64_t>& result) {
+    uint64_t n = a.size();
+    result.resize(n << 1);
+    if (n < KARATSUBA_WORDS) {
+        words_sqr_basecase(a.data(), n, result.data());
+    } else {
+        std::vector<uint64_t> scratch(words_karatsuba_scratch(n));
+        words_karatsuba(a.data(), a.data(), n, result.data(), scratch.data());
+    }
+    words_normalize(result);
+}
+
+// Adds b * c to a. Short factors are multiplied straight into a row by row
+// without forming the product, longer ones go through words_mul.
+void words_add_mul(std::vector<uint64_t>& a, const std::vector<uint64_t>& b,
+        const std::vector<uint64_t>& c) {
+    if (b.empty() || c.empty()) return;
+    const std::vector<uint64_t>& shorter = b.size() <= c.size() ? b : c;
+    const std::vector<uint64_t>& longer = b.size() <= c.size() ? c : b;
+    if (shorter.size() >= KARATSUBA_WORDS) {
+        words_add(a, words_mul(b, c));
+        return;
+    }
+    if (a.size() < b.size() + c.size()) a.resize(b.size() + c.size(), 0);
+    for (uint64_t i = 0; i < shorter.size(); ++i) {
+        unsigned __int128 carry = 0;
+        for (uint64_t j = 0; j < longer.size(); ++j) {
+            carry += (unsigned __int128)shorter[i] * longer[j] + a[i + j];
+            a[i + j] = uint64_t(carry);
+            carry >>= 64;
+        }
+        for (uint64_t k = i + longer.size(); carry != 0; ++k) {
+            if (k == a.size()) a.emplace_back(0);
+            carry += a[k];
+            a[k] = uint64_t(carry);
+            carry >>= 64;
+        }
+    }
+    words_normalize(a);
+}
+
+// Multiplies every value in level with a balanced product tree. Each level
+// multiplies neighbouring partial products together so both operands of a
+// multiplication stay roughly the same size and take the Karatsuba path
+// instead of the quadratic one. level is used up, and an empty level has a
+// product of one.
+std::vector<uint64_t> words_product(std::vector<std::vector<uint64_t>>& level) {
+    if (level.empty()) return std::vector<uint64_t>(1, 1);
+    while (level.size() > 1) {
+        uint64_t half = level.size() >> 1;
+        for (uint64_t i = 0; i < half; ++i)
+            level[i] = words_mul(level[i << 1], level[(i << 1) + 1]);
+        if (level.size() & 1)
+            level[half].swap(level.back());
+        level.resize(level.size() - half);
+    }
+    return std::move(level[0]);
+}
+
+void words_shift_right(std::vector<uint64_t>& a, const uint64_t& n) {
+    uint64_t words = n >> 6, shift = n & 63;
+    if (words >= a.size()) {
+        a.clear();
+        return;
+    }
+    for (uint64_t i = 0; i + words < a.size(); ++i) {
+        a[i] = a[i + words] >> shift;
+        if (shift != 0 && i + words + 1 < a.size())
+            a[i] |= a[i + words + 1] << (64 - shift);
+    }
+    a.resize(a.size() - words);
+    words_normalize(a);
+}
+
+void words_shift_left(std::vector<uint64_t>& a, const uint64_t& n) {
+    if (a.empty()) return;
+    uint64_t words = n >> 6, shift = n & 63;
+    a.resize(a.size() + words + 1, 0);
+    for (uint64_t i = a.size() - 1; i != words - 1; --i) {
+        a[i] = a[i - words] << shift;
+        if (shift != 0 && i != words)
+            a[i] |= a[i - words - 1] >> (64 - shift);
+    }
+    for (uint64_t i = 0; i < words; ++i)
+        a[i] = 0;
+    words_normalize(a);
+}
+
+// Returns the 64 bits of a starting at bit n.
+uint64_t words_window(const std::vector<uint64_t>& a, const uint64_t& n) {
+    uint64_t word = n >> 6, shift = n & 63;
+    if (word >= a.size()) return 0;
+    uint64_t window = a[word] >> shift;
+    if (shift != 0 && word + 1 < a.size())
+        window |= a[word + 1] << (64 - shift);
+    return window;
+}
+
+// Knuth's Algorithm D (TAOCP vol. 2, 4.3.1). Each quotient word is estimated
+// from the top two words of the remainder and the top word of the divisor,
+// which is first shifted so that its highest bit is set, and corrected at
+// most twice.
+void words_div_mod(const std::vector<uint64_t>& u, const std::vector<uint64_t>& v,
+        std::vector<uint64_t>& q, std::vector<uint64_t>& r) {
+    if (v.empty()) {
+        throw std::runtime_error("ERROR: Division by zero");
+    }
+    if (words_compare(u, v) < 0) {
+        q.clear();
+        r = u;
+        return;
+    }
+    uint64_t n = v.size(), m = u.size() - n;
+    q.assign(m + 1, 0);
+    if (n == 1) {
+        unsigned __int128 remainder = 0;
+        for (uint64_t i = u.size() - 1; i != negative_one; --i) {
+            remainder = (remainder << 64) | u[i];
+            q[i] = uint64_t(remainder / v[0]);
+            remainder %= v[0];
+        }
+        words_normalize(q);
+        r.assign(1, uint64_t(remainder));
+        words_normalize(r);
+        return;
+    }
+    uint64_t s = __builtin_clzll(v[n - 1]);
+    std::vector<uint64_t> vn(n), un(u.size() + 1);
+    for (uint64_t i = n - 1; i != 0; --i)
+        vn[i] = (v[i] << s) | (s != 0 ? v[i - 1] >> (64 - s) : 0);
+    vn[0] = v[0] << s;
+    un[u.size()] = s != 0 ? u[u.size() - 1] >> (64 - s) : 0;
+    for (uint64_t i = u.size() - 1; i != 0; --i)
+        un[i] = (u[i] << s) | (s != 0 ? u[i - 1] >> (64 - s) : 0);
+    un[0] = u[0] << s;
+    for (uint64_t j = m; j != negative_one; --j) {
+        unsigned __int128 numerator = ((unsigned __int128)un[j + n] << 64) | un[j + n - 1];
+        unsigned __int128 qhat = numerator / vn[n - 1];
+        unsigned __int128 rhat = numerator % vn[n - 1];
+        while ((qhat >> 64) != 0
+                || qhat * vn[n - 2] > ((rhat << 64) | un[j + n - 2])) {
+            --qhat;
+            rhat += vn[n - 1];
+            if ((rhat >> 64) != 0) break;
+        }
+        unsigned __int128 carry = 0;
+        uint64_t borrow = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            carry += qhat * vn[i];
+            uint64_t product = uint64_t(carry);
+            carry >>= 64;
+            uint64_t difference = un[i + j] - product - borrow;
+            borrow = un[i + j] < product || (un[i + j] == product && borrow);
+            un[i + j] = difference;
+        }
+        uint64_t top = uint64_t(carry);
+        uint64_t difference = un[j + n] - top - borrow;
+        borrow = un[j + n] < top || (un[j + n] == top && borrow);
+        un[j + n] = difference;
+        q[j] = uint64_t(qhat);
+        if (borrow) {
+            --q[j];
+            carry = 0;
+            for (uint64_t i = 0; i < n; ++i) {
+                carry += (unsigned __int128)un[i + j] + vn[i];
+                un[i + j] = uint64_t(carry);
+                carry >>= 64;
+            }
+            un[j + n] += uint64_t(carry);
+        }
+    }
+    words_normalize(q);
+    r.resize(n);
+    for (uint64_t i = 0; i < n; ++i)
+        r[i] = (un[i] >> s) | (s != 0 ? un[i + 1] << (64 - s) : 0);
+    words_normalize(r);
+}
+
+} // End namespace atn
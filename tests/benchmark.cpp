@@ -2,31 +2,6 @@
 #include <chrono>
 #include <iostream>
 
-atn::uInt c, d;
-void fibo_fast(uint64_t n, atn::uInt res[]) {
-    if (n == 0) {
-        res[0] = atn::ZERO;
-        res[1] = atn::ONE;
-        return;
-    }
-    fibo_fast(n >> 1, res);
-    c = ((res[1] << 1) - res[0]) * res[0];
-    d = (res[0] * res[0] + res[1] * res[1]);
-    if (n % atn::TWO == atn::ZERO) {
-        res[0] = c;
-        res[1] = d;
-    } else {
-        res[0] = d;
-        res[1] = c + d;
-    }
-}
-
-atn::uInt fibo_fast(uint64_t n) {
-    atn::uInt res[2] = { 0 };
-    fibo_fast(n, res);
-    return res[0];
-}
-
 int main(int argc, char** argv) {
     uint64_t N = 100;
     if (argc > 1) {
@@ -36,11 +11,15 @@ int main(int argc, char** argv) {
     if (argc > 2) {
         F = std::stoi(argv[2]);
     }
+    uint64_t C = 100;
+    if (argc > 3) {
+        C = std::stoi(argv[3]);
+    }
     auto start = std::chrono::high_resolution_clock::now();
     atn::uInt n;
     std::string str;
     for (size_t i = 0; i < N; ++i) {
-        n = fibo_fast(F);
+        n = atn::fibonacci(F);
         str = n.to_string();
     }
     auto stop = std::chrono::high_resolution_clock::now();
@@ -48,6 +27,29 @@ int main(int argc, char** argv) {
     std::chrono::duration<double, std::milli> total = stop - start;
     std::cout << std::endl << "F(" << F << "), N=" << N << ", Average Runtime: " << total.count() / N << "ms" << std::endl;
     std::cout << "Decimal digits: " << str.size() << ", Binary digits: " << n.bits.size() << std::endl;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < N; ++i) {
+        n = atn::linear_recurrence({ atn::ONE, atn::ONE }, { atn::ZERO, atn::ONE }, F);
+    }
+    stop = std::chrono::high_resolution_clock::now();
+    total = stop - start;
+    std::cout << std::endl << "Kitamasa F(" << F << "), N=" << N << ", Average Runtime: " << total.count() / N << "ms" << std::endl;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < N; ++i) {
+        n = atn::factorial(C);
+    }
+    stop = std::chrono::high_resolution_clock::now();
+    total = stop - start;
+    std::cout << std::endl << C << "!, N=" << N << ", Average Runtime: " << total.count() / N << "ms" << std::endl;
+    std::cout << "Binary digits: " << n.bits.size() << std::endl;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < N; ++i) {
+        n = atn::binomial(C << 1, C);
+    }
+    stop = std::chrono::high_resolution_clock::now();
+    total = stop - start;
+    std::cout << std::endl << "C(" << (C << 1) << ", " << C << "), N=" << N << ", Average Runtime: " << total.count() / N << "ms" << std::endl;
+    std::cout << "Binary digits: " << n.bits.size() << std::endl;
     #if PERFORMANCE_TEST
         atn::print_performance_test_results();
     #endif
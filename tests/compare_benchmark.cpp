@@ -0,0 +1,125 @@
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Compares an operator benchmark CSV against a stored baseline for the same
+// machine class. An operation regresses when both its fastest trial and its
+// median are more than THRESHOLD percent slower than in the baseline, or when
+// it was run at smaller sizes this time but dropped by the time cutoff before
+// a size it was measured at in the baseline. Baseline sizes larger than any
+// size in the results were not run at all and are left out. Requiring both keeps a single descheduled trial, or a busy machine
+// slowing every trial a little, from being reported on its own. Times below
+// MIN_NS are compared as if they were MIN_NS, since a few nanoseconds of clock
+// noise would otherwise dominate the percentage. Exits with 1 if anything
+// regressed and 2 if a file cannot be read.
+
+#define MIN_NS 100.0
+
+typedef std::pair<std::string, uint64_t> key; // operation, bits
+typedef std::pair<double, double> timing; // min_ns, median_ns
+
+uint64_t find_column(const std::vector<std::string>& header, const std::string& name) {
+    uint64_t column = 0;
+    while (column < header.size() && header[column] != name)
+        ++column;
+    return column;
+}
+
+double change(const double& before, const double& after) {
+    double from = before < MIN_NS ? MIN_NS : before;
+    double to = after < MIN_NS ? MIN_NS : after;
+    return (to - from) / from * 100.0;
+}
+
+bool read_timings(const std::string& path, std::map<key, timing>& timings) {
+    std::ifstream file(path);
+    if (!file) return false;
+    std::string line;
+    std::getline(file, line); // header
+    std::vector<std::string> header;
+    std::stringstream columns(line);
+    std::string column;
+    while (std::getline(columns, column, ','))
+        header.emplace_back(column);
+    uint64_t min_column = find_column(header, "min_ns");
+    uint64_t median_column = find_column(header, "median_ns");
+    if (min_column == header.size() || median_column == header.size()) return false;
+    while (std::getline(file, line)) {
+        std::vector<std::string> fields;
+        std::stringstream row(line);
+        while (std::getline(row, column, ','))
+            fields.emplace_back(column);
+        if (fields.size() != header.size()) continue;
+        timings[key(fields[0], std::stoull(fields[1]))] =
+            timing(std::stod(fields[min_column]), std::stod(fields[median_column]));
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " BASELINE.csv RESULTS.csv [THRESHOLD]" << std::endl;
+        return 2;
+    }
+    double THRESHOLD = 50.0;
+    if (argc > 3) {
+        THRESHOLD = std::stod(argv[3]);
+    }
+    std::map<key, timing> baseline, results;
+    if (!read_timings(argv[1], baseline)) {
+        std::cout << "No baseline at " << argv[1] << ", record one with make baseline" << std::endl;
+        return 2;
+    }
+    if (!read_timings(argv[2], results)) {
+        std::cout << "Cannot read " << argv[2] << std::endl;
+        return 2;
+    }
+    uint64_t largest = 0;
+    std::map<std::string, uint64_t> largest_run; // per operation
+    for (auto& entry : results) {
+        if (entry.first.second > largest) largest = entry.first.second;
+        if (entry.first.second > largest_run[entry.first.first])
+            largest_run[entry.first.first] = entry.first.second;
+    }
+    uint64_t regressions = 0, improvements = 0;
+    std::cout << std::setw(10) << "OPERATION" << std::setw(10) << "BITS"
+        << std::setw(16) << "BASELINE NS" << std::setw(16) << "MEDIAN NS"
+        << std::setw(10) << "MIN" << std::setw(10) << "MEDIAN" << std::endl;
+    for (auto& entry : baseline) {
+        if (entry.first.second > largest) continue;
+        auto found = results.find(entry.first);
+        std::cout << std::setw(10) << entry.first.first << std::setw(10) << entry.first.second
+            << std::setw(16) << std::fixed << std::setprecision(1) << entry.second.second;
+        if (found == results.end()) {
+            if (largest_run.count(entry.first.first) != 0) {
+                std::cout << std::setw(16) << "skipped" << std::setw(20) << "" << "  REGRESSION" << std::endl;
+                ++regressions;
+            } else {
+                std::cout << std::setw(16) << "not run" << std::endl;
+            }
+            continue;
+        }
+        double min_change = change(entry.second.first, found->second.first);
+        double median_change = change(entry.second.second, found->second.second);
+        std::cout << std::setw(16) << found->second.second << std::showpos
+            << std::setw(9) << min_change << "%" << std::setw(9) << median_change
+            << "%" << std::noshowpos;
+        if (min_change > THRESHOLD && median_change > THRESHOLD) {
+            std::cout << "  REGRESSION";
+            ++regressions;
+        } else if (min_change < -THRESHOLD && median_change < -THRESHOLD) {
+            std::cout << "  improved";
+            ++improvements;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl << regressions << " regressions and " << improvements
+        << " improvements beyond " << THRESHOLD << "% against " << argv[1] << std::endl;
+    return regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+#include "../src/uInt.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+// Times every operator on random operands whose size doubles from 64 bits up
+// to MAX_BITS. Each (operator, size) pair is warmed up, then timed for TRIALS
+// trials. A trial runs the operator REPS times on fresh copies of its operands
+// so that very fast operators are not dominated by the clock. Slow pairs stop
+// early once they use up their time budget, and an operator is dropped from
+// the larger sizes once a single run takes longer than the cutoff.
+
+#define TRIAL_BUDGET_MS 250.0 // per operator and size
+#define SIZE_CUTOFF_MS 250.0 // largest single run before skipping larger sizes
+#define MIN_TRIAL_NS 10000.0 // fast operators are repeated until a trial takes this long
+#define MAX_REPS 1024
+
+typedef std::chrono::duration<double, std::nano> nanoseconds;
+
+enum operation {
+    ADD, SUB, MUL, SQR, DIV, MOD, SHL, SHR, AND, OR, XOR, EQ, LT, PARSE, TO_STRING,
+    NUM_OF_OPERATIONS
+};
+
+const char* operation_names[NUM_OF_OPERATIONS] = {
+    "add", "sub", "mul", "sqr", "div", "mod", "shl", "shr", "and", "or", "xor",
+    "eq", "lt", "parse", "to_string"
+};
+
+struct result {
+    std::string name;
+    uint64_t bits;
+    uint64_t trials;
+    uint64_t reps;
+    double min, median, p90, p99;
+};
+
+atn::uInt random_uInt(std::mt19937_64& rng, const uint64_t& bits) {
+    std::vector<uint64_t> words((bits + 63) >> 6);
+    for (auto& word : words)
+        word = rng();
+    if (bits & 63) words.back() &= (uint64_t(1) << (bits & 63)) - 1;
+    words.back() |= uint64_t(1) << ((bits - 1) & 63);
+    atn::uInt n;
+    atn::import_bits(n, words.size(), -1, sizeof(uint64_t), 0, 0, words.data());
+    return n;
+}
+
+// The number of comparisons which held. It is printed at the end so the
+// compiler cannot drop the comparisons being timed.
+uint64_t true_comparisons = 0;
+
+// Runs one operation on each of the prepared copies and returns the average
+// time per operation.
+double run(const operation& op, std::vector<atn::uInt>& copies, const atn::uInt& b,
+        const std::string& str, const uint64_t& shift) {
+    static std::string text;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto& x : copies) {
+        switch (op) {
+            case ADD: x += b; break;
+            case SUB: x -= b; break;
+            case MUL: case SQR: x *= b; break;
+            case DIV: x /= b; break;
+            case MOD: x %= b; break;
+            case SHL: x <<= shift; break;
+            case SHR: x >>= shift; break;
+            case AND: x &= b; break;
+            case OR: x |= b; break;
+            case XOR: x ^= b; break;
+            case EQ: true_comparisons += x == b; break;
+            case LT: true_comparisons += x < b; break;
+            case PARSE: x = atn::uInt(str); break;
+            case TO_STRING: text = x.to_string(); break;
+            default: break;
+        }
+    }
+    nanoseconds elapsed = std::chrono::high_resolution_clock::now() - start;
+    return elapsed.count() / copies.size();
+}
+
+double percentile(const std::vector<double>& sorted, const double& p) {
+    uint64_t rank = uint64_t(p * sorted.size() + 0.999999);
+    return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+int main(int argc, char** argv) {
+    uint64_t MAX_BITS = 16777216;
+    if (argc > 1) {
+        MAX_BITS = std::stoull(argv[1]);
+    }
+    uint64_t TRIALS = 15;
+    if (argc > 2) {
+        TRIALS = std::stoull(argv[2]);
+    }
+    std::string OUTPUT = "data/operator_benchmark";
+    if (argc > 3) {
+        OUTPUT = argv[3];
+    }
+    std::mt19937_64 rng(0);
+    std::vector<result> results;
+    std::vector<bool> skipped(NUM_OF_OPERATIONS, false);
+    std::cout << std::setw(10) << "OPERATION" << std::setw(10) << "BITS"
+        << std::setw(14) << "MEDIAN NS" << std::setw(14) << "P90 NS"
+        << std::setw(14) << "NS/LIMB" << std::endl;
+    for (uint64_t bits = 64; bits <= MAX_BITS; bits <<= 1) {
+        atn::uInt a = random_uInt(rng, bits), b = random_uInt(rng, bits);
+        atn::uInt half = random_uInt(rng, (bits >> 1) + 1);
+        std::string str = skipped[PARSE] ? std::string() : a.to_string();
+        for (uint64_t i = 0; i < NUM_OF_OPERATIONS; ++i) {
+            if (skipped[i]) continue;
+            operation op = operation(i);
+            const atn::uInt& first = op == SUB && a < b ? b : a;
+            const atn::uInt& second = op == DIV || op == MOD ? half
+                : op == SQR ? first : (op == SUB && a < b ? a : b);
+            uint64_t shift = bits >> 1;
+            std::vector<atn::uInt> copies(1, first);
+            double single = run(op, copies, second, str, shift);
+            uint64_t reps = 1;
+            while (reps < MAX_REPS && single * reps < MIN_TRIAL_NS)
+                reps <<= 1;
+            std::vector<double> times;
+            double spent = 0;
+            for (uint64_t trial = 0; trial < TRIALS + 1; ++trial) {
+                copies.assign(reps, first);
+                double time = run(op, copies, second, str, shift);
+                spent += time * reps / 1e6;
+                if (trial != 0) times.emplace_back(time); // the first trial is a warm-up
+                if (times.size() >= 3 && spent > TRIAL_BUDGET_MS) break;
+            }
+            std::sort(times.begin(), times.end());
+            result r = { operation_names[i], bits, times.size(), reps,
+                times.front(), percentile(times, 0.5), percentile(times, 0.9),
+                percentile(times, 0.99) };
+            results.emplace_back(r);
+            std::cout << std::setw(10) << r.name << std::setw(10) << bits
+                << std::setw(14) << std::fixed << std::setprecision(1) << r.median
+                << std::setw(14) << r.p90
+                << std::setw(14) << r.median / (bits >> 6) << std::endl;
+            if (r.median / 1e6 > SIZE_CUTOFF_MS) skipped[i] = true;
+        }
+    }
+    std::ofstream csv(OUTPUT + ".csv");
+    csv << "operation,bits,limbs,trials,reps,min_ns,median_ns,p90_ns,p99_ns,median_ns_per_limb" << std::endl;
+    csv << std::fixed << std::setprecision(1);
+    for (auto& r : results) {
+        csv << r.name << ',' << r.bits << ',' << (r.bits >> 6) << ',' << r.trials << ','
+            << r.reps << ',' << r.min << ',' << r.median << ',' << r.p90 << ','
+            << r.p99 << ',' << r.median / (r.bits >> 6) << std::endl;
+    }
+    std::ofstream json(OUTPUT + ".json");
+    json << "[" << std::endl << std::fixed << std::setprecision(1);
+    for (uint64_t i = 0; i < results.size(); ++i) {
+        const result& r = results[i];
+        json << "  {\"operation\": \"" << r.name << "\", \"bits\": " << r.bits
+            << ", \"limbs\": " << (r.bits >> 6) << ", \"trials\": " << r.trials
+            << ", \"reps\": " << r.reps << ", \"min_ns\": " << r.min
+            << ", \"median_ns\": " << r.median << ", \"p90_ns\": " << r.p90
+            << ", \"p99_ns\": " << r.p99 << ", \"median_ns_per_limb\": "
+            << r.median / (r.bits >> 6) << "}" << (i + 1 < results.size() ? "," : "")
+            << std::endl;
+    }
+    json << "]" << std::endl;
+    std::cout << "Comparisons which held: " << true_comparisons << std::endl;
+}
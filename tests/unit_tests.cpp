@@ -1,12 +1,21 @@
 #include "../src/uInt.hpp"
+#include "../src/fixed_uInt.hpp"
+#include "../src/mapped_uInt.hpp"
+#include "../src/shared_uInt.hpp"
+#include "../src/accumulator.hpp"
+#include "../src/rns_uInt.hpp"
 #include <bitset>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
 #include <string>
 #include <sstream>
+#include <thread>
 #include <time.h>
+#include <unistd.h>
 
 
 #define TEST(title, n, actual, expected, edge_case) \
@@ -155,6 +164,24 @@ bool test_shift_right(uint64_t n) {
     return result;
 }
 
+bool test_shift_words(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    atn::uInt u1 = n1, u2 = n2, big = u1 * u2 * u1 * u2 * u1 + u2, shifted;
+    std::string binary = big.to_string(2);
+    uint64_t pos = n2 % 300;
+    TEST("TEST_SHIFT_WORDS", 1, (big << pos).to_string(2), binary + std::string(pos, '0'), false)
+    std::string expected = pos < binary.size() ? binary.substr(0, binary.size() - pos) : "0";
+    TEST("TEST_SHIFT_WORDS", 2, (big >> pos).to_string(2), expected, false)
+    shifted = big;
+    shifted <<= pos;
+    shifted >>= pos;
+    TEST("TEST_SHIFT_WORDS", 3, shifted, big, false)
+    shifted >>= binary.size();
+    TEST("TEST_SHIFT_WORDS", 4, shifted, atn::ZERO, false)
+    TEST("TEST_SHIFT_WORDS", 5, big >> (binary.size() + pos), atn::ZERO, false)
+    return result;
+}
+
 bool test_and(uint64_t n1, uint64_t n2) {
     bool result = true;
     atn::uInt u1 = n1, u2 = n2;
@@ -266,6 +293,603 @@ bool test_to_string(uint64_t n) {
     return result;
 }
 
+bool test_product(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    std::vector<uint64_t> factors = { n1, n2, 3, n1 + n2 };
+    atn::uInt u1 = n1, u2 = n2, expected = u1 * u2 * 3 * (u1 + u2);
+    TEST("TEST_PRODUCT", 1, atn::product(factors.begin(), factors.end()), expected, false)
+    TEST("TEST_PRODUCT", 2, atn::product(factors.begin(), factors.begin()), atn::ONE, false)
+    factors.emplace_back(0);
+    TEST("TEST_PRODUCT", 3, atn::product(factors.begin(), factors.end()), atn::ZERO, false)
+    std::vector<atn::uInt> values;
+    atn::uInt naive = 1;
+    for (uint64_t i = 0; i < 200; ++i) {
+        values.emplace_back((n1 ^ i) | 1);
+        naive *= (n1 ^ i) | 1;
+    }
+    TEST("TEST_PRODUCT", 4, atn::product(values.begin(), values.end()), naive, false)
+    return result;
+}
+
+bool test_factorial(uint64_t n) {
+    bool result = true;
+    uint64_t small = n % 21, expected = 1;
+    for (uint64_t i = 2; i <= small; ++i)
+        expected *= i;
+    TEST("TEST_FACTORIAL", 1, uint64_t(atn::factorial(small)), expected, false)
+    uint64_t large = n % 100 + 21;
+    atn::uInt naive = 1;
+    for (uint64_t i = 2; i <= large; ++i)
+        naive *= i;
+    TEST("TEST_FACTORIAL", 2, atn::factorial(large), naive, false)
+    for (uint64_t i = large + 1; i <= large + 3000; ++i)
+        naive *= i;
+    TEST("TEST_FACTORIAL", 3, atn::factorial(large + 3000), naive, false)
+    return result;
+}
+
+bool test_binomial(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    uint64_t n = n1 % 63, k = n2 % 64;
+    std::vector<uint64_t> row(1, 1);
+    for (uint64_t i = 1; i <= n; ++i) {
+        row.emplace_back(1);
+        for (uint64_t j = i - 1; j > 0; --j)
+            row[j] += row[j - 1];
+    }
+    TEST("TEST_BINOMIAL", 1, uint64_t(atn::binomial(n, k)), k <= n ? row[k] : 0, false)
+    n = n1 % 120;
+    k = n2 % (n + 1);
+    atn::uInt expected = atn::factorial(n), actual = atn::binomial(n, k);
+    actual *= atn::factorial(k);
+    actual *= atn::factorial(n - k);
+    TEST("TEST_BINOMIAL", 2, actual, expected, false)
+    return result;
+}
+
+bool test_fibonacci(uint64_t n) {
+    bool result = true;
+    uint64_t index = n % 94, f0 = 0, f1 = 1;
+    for (uint64_t i = 0; i < index; ++i) {
+        f1 += f0;
+        f0 = f1 - f0;
+    }
+    TEST("TEST_FIBONACCI", 1, uint64_t(atn::fibonacci(index)), f0, false)
+    index = n % 500;
+    atn::uInt u0 = 0, u1 = 1;
+    for (uint64_t i = 0; i < index; ++i) {
+        u0 += u1;
+        u0.bits.swap(u1.bits);
+    }
+    TEST("TEST_FIBONACCI", 2, atn::fibonacci(index), u0, false)
+    for (uint64_t i = index; i < index + 3000; ++i) {
+        u0 += u1;
+        u0.bits.swap(u1.bits);
+    }
+    TEST("TEST_FIBONACCI", 3, atn::fibonacci(index + 3000), u0, false)
+    TEST("TEST_FIBONACCI", 4, atn::lucas(index + 3000), u1 * 2 - u0, false)
+    return result;
+}
+
+bool test_lucas(uint64_t n) {
+    bool result = true;
+    uint64_t index = n % 90, l0 = 2, l1 = 1;
+    for (uint64_t i = 0; i < index; ++i) {
+        l1 += l0;
+        l0 = l1 - l0;
+    }
+    TEST("TEST_LUCAS", 1, uint64_t(atn::lucas(index)), l0, false)
+    return result;
+}
+
+bool test_linear_recurrence(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    std::vector<atn::uInt> coefficients = { n1 % 5, n2 % 5, 1 }, values = { 1, 2, 3 };
+    uint64_t index = n1 % 40;
+    for (uint64_t i = 3; i <= index; ++i)
+        values.emplace_back(values[i - 1] * coefficients[0] + values[i - 2] * coefficients[1] + values[i - 3]);
+    TEST("TEST_LINEAR_RECURRENCE", 1, atn::linear_recurrence(coefficients, { 1, 2, 3 }, index), values[index], false)
+    index = n2 % 500;
+    TEST("TEST_LINEAR_RECURRENCE", 2, atn::linear_recurrence({ 1, 1 }, { 0, 1 }, index), atn::fibonacci(index), false)
+    TEST("TEST_LINEAR_RECURRENCE", 3, atn::linear_recurrence({ 1, 1 }, { 2, 1 }, index), atn::lucas(index), false)
+    TEST("TEST_LINEAR_RECURRENCE", 4, atn::linear_recurrence({ 2 }, { 1 }, index % 64), uint64_t(1) << (index % 64), false)
+    uint64_t c0 = n1 % 5 + 3, c1 = n2 % 5;
+    index += 1000;
+    values.assign({ 1, 2, 3 });
+    for (uint64_t i = 3; i <= index; ++i)
+        values.emplace_back(values[i - 1] * c0 + values[i - 2] * c1 + values[i - 3]);
+    TEST("TEST_LINEAR_RECURRENCE", 5, atn::linear_recurrence({ c0, c1, 1 }, { 1, 2, 3 }, index), values[index], false)
+    return result;
+}
+
+static_assert(uint64_t(atn::fixed_uInt<128>(6) * atn::fixed_uInt<128>(7)) == 42, "fixed_uInt is not constexpr");
+static_assert(uint64_t((atn::fixed_uInt<256>(1) << 200) / ((atn::fixed_uInt<256>(1) << 130) + 1)) == atn::negative_one,
+    "fixed_uInt division is not constexpr");
+
+bool test_fixed_uInt(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    atn::fixed_uInt<64> f1 = n1, f2 = n2;
+    TEST("TEST_FIXED_UINT", 1, uint64_t(f1 + f2), n1 + n2, false)
+    TEST("TEST_FIXED_UINT", 2, uint64_t(f2 - f1), n2 - n1, false)
+    TEST("TEST_FIXED_UINT", 3, uint64_t(f1 * f2), n1 * n2, false)
+    TEST("TEST_FIXED_UINT", 4, uint64_t(f1 / f2), n1 / n2, false)
+    TEST("TEST_FIXED_UINT", 5, uint64_t(f1 % f2), n1 % n2, false)
+    TEST("TEST_FIXED_UINT", 6, uint64_t(f1 << 7), n1 << 7, false)
+    TEST("TEST_FIXED_UINT", 7, uint64_t(f1 >> 7), n1 >> 7, false)
+    TEST("TEST_FIXED_UINT", 8, uint64_t(f1 & f2), n1 & n2, false)
+    TEST("TEST_FIXED_UINT", 9, uint64_t(f1 | f2), n1 | n2, false)
+    TEST("TEST_FIXED_UINT", 10, uint64_t(f1 ^ f2), n1 ^ n2, false)
+    TEST("TEST_FIXED_UINT", 11, f1 < f2, n1 < n2, false)
+    TEST("TEST_FIXED_UINT", 12, f1 == f2, n1 == n2, false)
+    atn::uInt u1 = n1, u2 = n2, big = u1 * u2 * u1 * u2 + u1;
+    atn::fixed_uInt<256> b1(big), b2 = n2;
+    TEST("TEST_FIXED_UINT", 13, atn::uInt(b1), big, false)
+    TEST("TEST_FIXED_UINT", 14, atn::uInt(b1 / b2), big / u2, false)
+    TEST("TEST_FIXED_UINT", 15, atn::uInt(b1 % (b2 * b2 + 1)), big % (u2 * u2 + 1), false)
+    TEST("TEST_FIXED_UINT", 16, atn::uInt((b1 << 100) >> 100), big, false)
+    TEST("TEST_FIXED_UINT", 17, atn::uInt(--atn::fixed_uInt<256>(0)), (atn::ONE << 256) - 1, false)
+    TEST("TEST_FIXED_UINT", 18, (b1 * b2).to_string(), (big * u2).to_string(), false)
+    atn::uInt wide = big * big + u2, divisor = (u1 << 70) + u2 + 1;
+    atn::fixed_uInt<512> w1(wide), w2(divisor);
+    TEST("TEST_FIXED_UINT", 19, atn::uInt(w1 / w2), wide / divisor, false)
+    TEST("TEST_FIXED_UINT", 20, atn::uInt(w1 % w2), wide % divisor, false)
+    atn::fixed_uInt<200> t1(wide), t2(big + 1);
+    TEST("TEST_FIXED_UINT", 21, atn::uInt(t1 / t2), atn::uInt(t1) / atn::uInt(t2), false)
+    TEST("TEST_FIXED_UINT", 22, atn::uInt(t1 % t2), atn::uInt(t1) % atn::uInt(t2), false)
+    std::istringstream stream(big.to_string());
+    atn::fixed_uInt<256> read;
+    stream >> read;
+    TEST("TEST_FIXED_UINT", 23, read, b1, false)
+    return result;
+}
+
+bool test_import_export(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    atn::uInt u;
+    uint8_t little[8], big[8];
+    for (uint64_t i = 0; i < 8; ++i) {
+        little[i] = uint8_t(n1 >> (i << 3));
+        big[7 - i] = little[i];
+    }
+    atn::import_bits(u, 8, -1, 1, 0, 0, little);
+    TEST("TEST_IMPORT_EXPORT", 1, uint64_t(u), n1, false)
+    atn::import_bits(u, 8, 1, 1, 0, 0, big);
+    TEST("TEST_IMPORT_EXPORT", 2, uint64_t(u), n1, false)
+    atn::import_bits(u, 1, 1, 8, 1, 0, big);
+    TEST("TEST_IMPORT_EXPORT", 3, uint64_t(u), n1, false)
+    atn::import_bits(u, 1, -1, 8, 0, 0, &n2);
+    TEST("TEST_IMPORT_EXPORT", 4, uint64_t(u), n2, false)
+    atn::uInt u1 = n1, u2 = n2, value = u1 * u2 * u1 * u2 + u2, round_trip;
+    std::vector<uint8_t> buffer(atn::export_count(value, 3, 5) * 3);
+    uint64_t count = atn::export_bits(buffer.data(), 1, 3, 1, 5, value);
+    atn::import_bits(round_trip, count, 1, 3, 1, 5, buffer.data());
+    TEST("TEST_IMPORT_EXPORT", 5, round_trip, value, false)
+    uint64_t word = 0;
+    atn::export_bits(&word, -1, 8, 0, 0, u2);
+    TEST("TEST_IMPORT_EXPORT", 6, word, n2, false)
+    for (int endian : { -1, 1 }) {
+        std::vector<uint8_t> wide(atn::export_count(value, 12, 7) * 12);
+        count = atn::export_bits(wide.data(), -1, 12, endian, 7, value);
+        atn::import_bits(round_trip, count, -1, 12, endian, 7, wide.data());
+        TEST("TEST_IMPORT_EXPORT", 7, round_trip, value, false)
+    }
+    atn::import_bits(round_trip, 1, 1, 1, 0, 3, big + 7);
+    TEST("TEST_IMPORT_EXPORT", 8, uint64_t(round_trip), uint64_t(big[7] & 31), false)
+    return result;
+}
+
+bool test_mapped_uInt(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    std::string prefix = "/tmp/uInt_mapped_" + std::to_string(getpid());
+    atn::uInt u1 = n1, u2 = n2, big = u1 * u2 * u1 * u2 * u1 + u2;
+    {
+        atn::mapped_uInt m1(prefix + "_1", big), m2(prefix + "_2", u2), m3(prefix + "_3");
+        TEST("TEST_MAPPED_UINT", 1, atn::uInt(m1), big, false)
+        m3.multiply(m1, m2);
+        TEST("TEST_MAPPED_UINT", 2, atn::uInt(m3), big * u2, false)
+        m1 += m2;
+        TEST("TEST_MAPPED_UINT", 3, atn::uInt(m1), big + u2, false)
+        m1 += m1;
+        TEST("TEST_MAPPED_UINT", 4, atn::uInt(m1), (big + u2) << 1, false)
+        m1.sync();
+        atn::mapped_uInt m4(prefix + "_4", atn::pow(big, 9)), m5(prefix + "_5", atn::pow(big + n1, 22)), m6(prefix + "_6");
+        m6.multiply(m5, m4);
+        TEST("TEST_MAPPED_UINT", 6, atn::uInt(m6), atn::pow(big, 9) * atn::pow(big + n1, 22), false)
+    }
+    {
+        atn::mapped_uInt reopened(prefix + "_1");
+        TEST("TEST_MAPPED_UINT", 5, atn::uInt(reopened), (big + u2) << 1, false)
+    }
+    for (std::string suffix : { "_1", "_2", "_3", "_4", "_5", "_6" })
+        std::remove((prefix + suffix).c_str());
+    return result;
+}
+
+// Slices of a view must match the same bits cut out with shifts and masks.
+bool test_uInt_view(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    atn::uInt big = (atn::uInt(n1 | 1) << 200) + (atn::uInt(n2) << 70) + n1;
+    atn::uInt mask = (atn::uInt(1) << 90) - 1;
+    uint64_t offset = n2 % 150;
+    atn::uInt_view view(big), middle = view.window(offset, 90);
+    std::vector<uint64_t> words = atn::to_words(big);
+    atn::uInt_view from_words(words.data(), words.size());
+    TEST("TEST_UINT_VIEW", 1, atn::uInt(middle), (big >> offset) & mask, false)
+    TEST("TEST_UINT_VIEW", 2, atn::uInt(view.low_bits(90)), big & mask, false)
+    TEST("TEST_UINT_VIEW", 3, atn::uInt(view.high_words(2)), big >> ((words.size() - 2) << 6), false)
+    TEST("TEST_UINT_VIEW", 4, middle.bit_length(), ((big >> offset) & mask).bit_length(), false)
+    TEST("TEST_UINT_VIEW", 5, middle.popcount(), ((big >> offset) & mask).popcount(), false)
+    TEST("TEST_UINT_VIEW", 6, middle.to_string(), ((big >> offset) & mask).to_string(), false)
+    TEST("TEST_UINT_VIEW", 7, from_words == big, true, false)
+    TEST("TEST_UINT_VIEW", 8, big < from_words.window(1, 300), false, false)
+    TEST("TEST_UINT_VIEW", 9, atn::uInt(n2) += middle, ((big >> offset) & mask) + n2, false)
+    TEST("TEST_UINT_VIEW", 10, atn::uInt(big) -= middle, big - ((big >> offset) & mask), false)
+    TEST("TEST_UINT_VIEW", 11, atn::uInt(n1) *= view.window(64, 100), atn::uInt(n1) * ((big >> 64) & ((atn::uInt(1) << 100) - 1)), false)
+    TEST("TEST_UINT_VIEW", 12, atn::uInt(middle) -= view, atn::ZERO, false)
+    return result;
+}
+
+// Copies share one value until one of them changes, and handles sharing a
+// value can be copied and dropped from several threads at once.
+bool test_shared_uInt(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    atn::uInt big = (atn::uInt(n1) << 300) + n2;
+    atn::shared_uInt a(big), b = a;
+    std::vector<atn::shared_uInt> copies(8, a);
+    TEST("TEST_SHARED_UINT", 1, b.shares_storage(a), true, false)
+    TEST("TEST_SHARED_UINT", 2, a.use_count(), uint64_t(10), false)
+    ++b;
+    TEST("TEST_SHARED_UINT", 3, b.shares_storage(a), false, false)
+    TEST("TEST_SHARED_UINT", 4, a.get(), big, false)
+    TEST("TEST_SHARED_UINT", 5, b.get(), big + 1, false)
+    TEST("TEST_SHARED_UINT", 6, a < b, true, false)
+    copies[0] += copies[1];
+    TEST("TEST_SHARED_UINT", 7, copies[0].get(), big << 1, false)
+    TEST("TEST_SHARED_UINT", 8, copies[1] == a, true, false)
+    std::vector<std::thread> workers;
+    for (uint64_t t = 0; t < 4; ++t) {
+        workers.emplace_back([&copies, t]() {
+            std::vector<atn::shared_uInt> local;
+            for (uint64_t i = 0; i < 1000; ++i)
+                local.emplace_back(copies[t + 1]);
+            local.back() *= 3;
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+    TEST("TEST_SHARED_UINT", 9, a.use_count(), uint64_t(8), false)
+    TEST("TEST_SHARED_UINT", 10, copies[4].get(), big, false)
+    return result;
+}
+
+// A sum of values and products read from an accumulator must match the same
+// sum built with operator+=, including once it has been read and added to.
+bool test_accumulator(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    atn::uInt big = (atn::uInt(n1) << 200) - n2, expected;
+    atn::accumulator sum;
+    for (uint64_t i = 0; i < 16; ++i) {
+        atn::uInt term = (big << (i * 3)) + i * n2;
+        sum += term;
+        sum.add_product(term, big);
+        sum.add_product(big, n1 + i);
+        sum += n2 << (i % 8);
+        expected += term + term * big + big * (n1 + i) + (n2 << (i % 8));
+    }
+    TEST("TEST_ACCUMULATOR", 1, sum.value(), expected, false)
+    sum += atn::uInt(1) << 2000;
+    TEST("TEST_ACCUMULATOR", 2, sum.value(), expected + (atn::uInt(1) << 2000), false)
+    sum.clear();
+    sum += atn::ZERO;
+    sum.add_product(atn::ZERO, big);
+    TEST("TEST_ACCUMULATOR", 3, sum.value(), atn::ZERO, false)
+    std::vector<uint64_t> ones(20, atn::negative_one);
+    atn::accumulator saturated(atn::uInt_view(ones.data(), ones.size()));
+    for (uint64_t i = 0; i < 1000; ++i)
+        saturated.add_product(atn::uInt_view(ones.data(), ones.size()), atn::negative_one);
+    atn::uInt top = (atn::uInt(1) << 1280) - 1;
+    TEST("TEST_ACCUMULATOR", 4, saturated.value(), top + top * atn::negative_one * 1000, false)
+    return result;
+}
+
+// Arithmetic done residue by residue must read back as the same atn::uInt
+// arithmetic, and the threaded batch conversions must match single ones.
+bool test_rns_uInt(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    static const std::shared_ptr<const atn::rns_basis> basis = std::make_shared<atn::rns_basis>(1024);
+    atn::uInt a = (atn::uInt(n1 | 1) << 200) + n2, b = (atn::uInt(n2) << 100) + n1;
+    atn::rns_uInt x(basis, a), y(basis, b);
+    uint64_t i = n2 % basis->size();
+    TEST("TEST_RNS_UINT", 1, atn::uInt(x), a, false)
+    TEST("TEST_RNS_UINT", 2, atn::uInt(x * y + x - y), a * b + a - b, false)
+    TEST("TEST_RNS_UINT", 3, x.residue(i), uint64_t(a % basis->prime(i)), false)
+    x *= n1;
+    x += n2;
+    x -= 1;
+    TEST("TEST_RNS_UINT", 4, atn::uInt(x), a * n1 + n2 - 1, false)
+    atn::rns_uInt zero(basis), wrapped = zero;
+    wrapped -= n2 + 1;
+    wrapped += n2 + 1;
+    TEST("TEST_RNS_UINT", 5, wrapped == zero, true, false)
+    atn::uInt top = (atn::uInt(1) << basis->bits()) - 1;
+    TEST("TEST_RNS_UINT", 6, atn::uInt(atn::rns_uInt(basis, top)), top, false)
+    std::vector<atn::uInt> values = { a, b, a * b, atn::ZERO };
+    std::vector<atn::uInt> round_trip = atn::from_rns(atn::to_rns(basis, values, 2), 2);
+    TEST("TEST_RNS_UINT", 7, round_trip == values, true, false)
+    return result;
+}
+
+bool test_streams(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    atn::uInt u1 = n1, u2 = n2, big = u1 * u2 * u1 * u2 * u1 * u2, parsed;
+    std::stringstream expected, actual;
+    expected << n1 << ' ' << std::hex << n1 << ' ' << std::oct << n1 << ' '
+        << std::uppercase << std::showbase << std::hex << n2 << ' '
+        << std::setw(30) << std::setfill('*') << std::left << n2 << ' '
+        << std::setw(30) << std::internal << n2 << ' '
+        << std::setw(30) << std::right << std::dec << n2 << ' ' << std::oct << 0;
+    actual << u1 << ' ' << std::hex << u1 << ' ' << std::oct << u1 << ' '
+        << std::uppercase << std::showbase << std::hex << u2 << ' '
+        << std::setw(30) << std::setfill('*') << std::left << u2 << ' '
+        << std::setw(30) << std::internal << u2 << ' '
+        << std::setw(30) << std::right << std::dec << u2 << ' ' << std::oct << atn::ZERO;
+    TEST("TEST_STREAMS", 1, actual.str(), expected.str(), false)
+    std::stringstream decimal;
+    decimal << big;
+    TEST("TEST_STREAMS", 2, decimal.str(), big.to_string(), false)
+    decimal >> parsed;
+    TEST("TEST_STREAMS", 3, parsed, big, false)
+    std::stringstream mixed;
+    mixed << std::hex << big << " 0x" << u1 << " " << std::oct << u2 << " z";
+    mixed >> std::hex >> parsed;
+    TEST("TEST_STREAMS", 4, parsed, big, false)
+    mixed >> parsed;
+    TEST("TEST_STREAMS", 5, parsed, u1, false)
+    mixed >> std::oct >> parsed;
+    TEST("TEST_STREAMS", 6, parsed, u2, false)
+    mixed >> std::dec >> parsed;
+    TEST("TEST_STREAMS", 7, mixed.fail(), true, false)
+    atn::uInt huge = atn::pow(big, 4) + n2;
+    std::stringstream chunked;
+    chunked << huge << ";" << std::hex << huge << ";" << std::oct << huge << ";";
+    char separator = 0;
+    chunked >> std::dec >> parsed >> separator;
+    TEST("TEST_STREAMS", 8, parsed, huge, false)
+    chunked >> std::hex >> parsed >> separator;
+    TEST("TEST_STREAMS", 9, parsed, huge, false)
+    chunked >> std::oct >> parsed >> separator;
+    TEST("TEST_STREAMS", 10, parsed, huge, false)
+    TEST("TEST_STREAMS", 11, separator, ';', false)
+    return result;
+}
+
+std::string to_base_string(uint64_t n, uint64_t base) {
+    const std::string& symbols = base == 64 ? atn::base64_index : atn::base_n_index;
+    std::string result("");
+    while (n != 0) {
+        result = symbols[n % base] + result;
+        n /= base;
+    }
+    return result;
+}
+
+bool test_base_conversion(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    atn::uInt u1 = n1, u2 = n2, big = u1 * u2 * u1 * u2 * u1 + u2;
+    uint64_t test = 1;
+    for (uint64_t base : { 2, 3, 4, 7, 8, 16, 32, 36, 64 }) {
+        TEST("TEST_BASE_CONVERSION", test, u1.to_string(base), to_base_string(n1, base), false)
+        TEST("TEST_BASE_CONVERSION", test + 1, atn::uInt(to_base_string(n2, base), base), u2, false)
+        TEST("TEST_BASE_CONVERSION", test + 2, atn::uInt(big.to_string(base), base), big, false)
+        test += 3;
+    }
+    TEST("TEST_BASE_CONVERSION", test, atn::uInt("0x00" + big.to_string(16)), big, false)
+    TEST("TEST_BASE_CONVERSION", test + 1, atn::uInt("00FfaB", 16), atn::uInt(0xffab), false)
+    return result;
+}
+
+bool test_literals(uint64_t n1) {
+    using namespace atn::literals;
+    bool result = true;
+    TEST("TEST_LITERALS", 1, 123456789012345678901234567890_u, atn::uInt("123456789012345678901234567890"), false)
+    TEST("TEST_LITERALS", 2, 0xFFFF'FFFF'FFFF'FFFF'FFFF_u, (atn::uInt(1) << 80) - 1, false)
+    TEST("TEST_LITERALS", 3, 0b1011_u + 0777_u + 0_u, atn::uInt(11 + 511), false)
+    TEST("TEST_LITERALS", 4, 18446744073709551616_u * n1, atn::uInt(n1) << 64, false)
+    return result;
+}
+
+bool test_bit_queries(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    atn::uInt u1 = n1, big = (atn::uInt(n2) << 200) + n1;
+    uint64_t pos = n2 % 64;
+    TEST("TEST_BIT_QUERIES", 1, u1.bit_length(), uint64_t(n1 == 0 ? 0 : 64 - __builtin_clzll(n1)), false)
+    TEST("TEST_BIT_QUERIES", 2, u1.popcount(), uint64_t(__builtin_popcountll(n1)), false)
+    TEST("TEST_BIT_QUERIES", 3, u1.count_trailing_zeros(), uint64_t(n1 == 0 ? 0 : __builtin_ctzll(n1)), false)
+    TEST("TEST_BIT_QUERIES", 4, u1.test_bit(pos), bool((n1 >> pos) & 1), false)
+    TEST("TEST_BIT_QUERIES", 5, big.popcount(), uint64_t(__builtin_popcountll(n1) + __builtin_popcountll(n2)), false)
+    TEST("TEST_BIT_QUERIES", 6, big.count_trailing_zeros(), u1.count_trailing_zeros(), n1 == 0)
+    TEST("TEST_BIT_QUERIES", 7, uint64_t(atn::uInt(n1).set_bit(pos)), n1 | (uint64_t(1) << pos), false)
+    TEST("TEST_BIT_QUERIES", 8, uint64_t(atn::uInt(n1).clear_bit(pos)), n1 & ~(uint64_t(1) << pos), false)
+    TEST("TEST_BIT_QUERIES", 9, atn::uInt(n1).set_bit(pos + 300).clear_bit(pos + 300), u1, false)
+    TEST("TEST_BIT_QUERIES", 10, atn::uInt(n1).set_bit(pos + 300).bit_length(), pos + 301, false)
+    return result;
+}
+
+// The word overloads must agree with the general operators, including when a
+// carry or borrow runs across a word boundary.
+bool test_word_arithmetic(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    atn::uInt big = (atn::uInt(n2 | 1) << 130) + n1, w1 = n1, w2 = n2;
+    atn::uInt ones = (atn::uInt(1) << 128) - 1, power = atn::uInt(1) << 128;
+    atn::uInt count = ones;
+    ++count;
+    TEST("TEST_WORD_ARITHMETIC", 1, big + n2, big + w2, false)
+    TEST("TEST_WORD_ARITHMETIC", 2, big - n2, big - w2, false)
+    TEST("TEST_WORD_ARITHMETIC", 3, big * n2, big * w2, false)
+    TEST("TEST_WORD_ARITHMETIC", 4, big / (n2 | 1), big / (w2 | atn::ONE), false)
+    TEST("TEST_WORD_ARITHMETIC", 5, big % (n2 | 1), big % (w2 | atn::ONE), false)
+    TEST("TEST_WORD_ARITHMETIC", 6, ones + 1, power, false)
+    TEST("TEST_WORD_ARITHMETIC", 7, power - 1, ones, false)
+    TEST("TEST_WORD_ARITHMETIC", 8, count, power, false)
+    TEST("TEST_WORD_ARITHMETIC", 9, --count, ones, false)
+    TEST("TEST_WORD_ARITHMETIC", 10, uint64_t(w1 + n2), n1 + n2, n1 + n2 < n1)
+    TEST("TEST_WORD_ARITHMETIC", 11, uint64_t(w1 - n2), n1 > n2 ? n1 - n2 : 0, false)
+    TEST("TEST_WORD_ARITHMETIC", 12, uint64_t(n1 - w2), n1 > n2 ? n1 - n2 : 0, false)
+    TEST("TEST_WORD_ARITHMETIC", 13, uint64_t(n1 / (w2 | atn::ONE)), n1 / (n2 | 1), false)
+    TEST("TEST_WORD_ARITHMETIC", 14, uint64_t(n1 % (w2 | atn::ONE)), n1 % (n2 | 1), false)
+    TEST("TEST_WORD_ARITHMETIC", 15, uint64_t(n1 % big), n1, false)
+    TEST("TEST_WORD_ARITHMETIC", 16, w1 == n1, true, false)
+    TEST("TEST_WORD_ARITHMETIC", 17, w1 < n2, n1 < n2, false)
+    TEST("TEST_WORD_ARITHMETIC", 18, w1 >= n2, n1 >= n2, false)
+    TEST("TEST_WORD_ARITHMETIC", 19, big > n1, true, false)
+    TEST("TEST_WORD_ARITHMETIC", 20, big != n1, true, false)
+    return result;
+}
+
+// Checks a * x + b * y = g using the sign flags of the extended result.
+bool bezout_holds(const atn::uInt& a, const atn::uInt& b, const atn::gcdext_result& e) {
+    atn::uInt positive = e.gcd, negative;
+    (e.x_negative ? positive : negative) += a * e.x;
+    (e.y_negative ? positive : negative) += b * e.y;
+    return positive == negative;
+}
+
+bool test_gcd(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    atn::uInt u1 = n1, u2 = n2;
+    atn::uInt f1 = atn::fibonacci(700 + n1 % 100), f2 = atn::fibonacci(701 + n1 % 100);
+    atn::uInt c = (atn::uInt(n2) << 64) + (n1 | 1);
+    atn::uInt a = f1 * c, b = f2 * c;
+    atn::gcdext_result small = atn::gcdext(u1, u2), big = atn::gcdext(a, b);
+    TEST("TEST_GCD", 1, uint64_t(atn::gcd(u1, u2)), std::gcd(n1, n2), false)
+    TEST("TEST_GCD", 2, uint64_t(atn::lcm(u1, u2)), std::lcm(n1, n2), false)
+    TEST("TEST_GCD", 3, atn::gcd(a, b), c, false)
+    TEST("TEST_GCD", 4, atn::gcd(a << 70, b << 3), c << std::min(f1.count_trailing_zeros() + 70, f2.count_trailing_zeros() + 3), false)
+    TEST("TEST_GCD", 5, atn::lcm(a, b), f1 * f2 * c, false)
+    TEST("TEST_GCD", 6, uint64_t(small.gcd), std::gcd(n1, n2), false)
+    TEST("TEST_GCD", 7, bezout_holds(u1, u2, small), true, false)
+    TEST("TEST_GCD", 8, big.gcd, c, false)
+    TEST("TEST_GCD", 9, bezout_holds(a, b, big), true, false)
+    TEST("TEST_GCD", 10, big.x <= b / c, true, false)
+    TEST("TEST_GCD", 11, atn::invert_mod(f1, f2) * f1 % f2, atn::ONE, false)
+    if (std::gcd(n1, n2) == 1) {
+        TEST("TEST_GCD", 12, uint64_t(atn::invert_mod(u1, u2) * u1 % u2), uint64_t(1 % n2), false)
+    }
+    return result;
+}
+
+bool test_roots(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    uint64_t product = n1 * n2, root = uint64_t(std::sqrt(double(product)));
+    while (root * root > product) --root;
+    while ((root + 1) * (root + 1) <= product) ++root;
+    atn::uInt x = (atn::uInt(n1) << 150) + n2 + 1;
+    std::pair<atn::uInt, atn::uInt> rem = atn::sqrtrem(x * x + n1);
+    TEST("TEST_ROOTS", 1, uint64_t(atn::isqrt(atn::uInt(product))), root, false)
+    TEST("TEST_ROOTS", 2, atn::isqrt(x * x), x, false)
+    TEST("TEST_ROOTS", 3, atn::isqrt(x * x - 1), x - 1, false)
+    TEST("TEST_ROOTS", 4, rem.first, x, false)
+    TEST("TEST_ROOTS", 5, rem.second, atn::uInt(n1), false)
+    TEST("TEST_ROOTS", 6, atn::iroot(x * x * x, 3), x, false)
+    TEST("TEST_ROOTS", 7, atn::iroot(x * x * x - 1, 3), x - 1, false)
+    TEST("TEST_ROOTS", 8, atn::rootrem(x * x * x * x * x + n2, 5).second, atn::uInt(n2), false)
+    TEST("TEST_ROOTS", 9, atn::iroot(x, 1000), atn::ONE, false)
+    TEST("TEST_ROOTS", 10, atn::iroot(atn::uInt(n1), 1), atn::uInt(n1), false)
+    return result;
+}
+
+bool test_pow(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    uint64_t exp = n2 % 12;
+    atn::uInt base = (atn::uInt(n2) << 70) + n1, expected = 1, even = base << (n1 % 7);
+    for (uint64_t i = 0; i < exp; ++i)
+        expected *= base;
+    atn::uInt even_expected = expected << (exp * (n1 % 7));
+    TEST("TEST_POW", 1, atn::pow(base, exp), expected, false)
+    TEST("TEST_POW", 2, atn::pow(even, exp), even_expected, false)
+    TEST("TEST_POW", 3, atn::pow(atn::TWO, n1 % 1000), atn::uInt(1) << (n1 % 1000), false)
+    TEST("TEST_POW", 4, atn::pow(atn::uInt(n1), 0), atn::ONE, false)
+    TEST("TEST_POW", 5, atn::pow(atn::ZERO, exp + 1), atn::ZERO, false)
+    TEST("TEST_POW", 6, atn::pow(atn::uInt(n1), 1), atn::uInt(n1), false)
+    TEST("TEST_POW", 7, atn::pow(atn::pow(base, 3), 5), atn::pow(base, 15), false)
+    atn::uInt threes = 1;
+    for (uint64_t i = 0; i < 300 + exp; ++i)
+        threes *= 3;
+    TEST("TEST_POW", 8, atn::pow(atn::THREE, 300 + exp), threes, false)
+    TEST("TEST_POW", 9, atn::pow(atn::pow(atn::THREE, 7000 + exp), 10), atn::pow(atn::THREE, 70000 + 10 * exp), false)
+    return result;
+}
+
+bool is_prime(uint64_t n) {
+    if (n < 2) return false;
+    for (uint64_t d = 2; d * d <= n; ++d) {
+        if (n % d == 0) return false;
+    }
+    return true;
+}
+
+bool test_primality(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    uint64_t next = n1 + 1;
+    while (!is_prime(next)) ++next;
+    atn::uInt mersenne = (atn::uInt(1) << 127) - 1, big = (atn::uInt(n2) << 100) + n1;
+    atn::uInt big_prime = atn::next_prime(big);
+    std::vector<atn::uInt> candidates = {n1, n2, mersenne, mersenne * mersenne, big_prime};
+    std::vector<bool> batch = atn::probable_primes(candidates, 2, 3);
+    TEST("TEST_PRIMALITY", 1, atn::is_probable_prime(n1), is_prime(n1), false)
+    TEST("TEST_PRIMALITY", 2, atn::is_probable_prime(n2 % 1000), is_prime(n2 % 1000), false)
+    TEST("TEST_PRIMALITY", 3, uint64_t(atn::next_prime(n1)), next, false)
+    TEST("TEST_PRIMALITY", 4, atn::is_probable_prime(mersenne), true, false)
+    TEST("TEST_PRIMALITY", 5, atn::is_probable_prime(mersenne * mersenne), false, false)
+    TEST("TEST_PRIMALITY", 6, atn::is_probable_prime(mersenne * (atn::uInt(1) << 61) - mersenne), false, false)
+    TEST("TEST_PRIMALITY", 7, big_prime > big, true, false)
+    TEST("TEST_PRIMALITY", 8, atn::is_probable_prime(big_prime, 4), true, false)
+    TEST("TEST_PRIMALITY", 9, atn::next_prime(big_prime - 1), big_prime, false)
+    for (uint64_t i = 0; i < candidates.size(); ++i) {
+        TEST("TEST_PRIMALITY", 10, batch[i], atn::is_probable_prime(candidates[i]), false)
+    }
+    return result;
+}
+
+#ifdef PERFORMANCE_TEST
+// Karatsuba recurses back into operator*=, which must still count as one call
+// on the karatsuba tier, and a worker thread's counters must survive its exit.
+bool test_performance_counters(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    atn::uInt a = (atn::uInt(n1) << 1000) + n2, b = (atn::uInt(n2) << 1000) + n1;
+    uint64_t bucket = 64 - __builtin_clzll(a.bits.size() + b.bits.size());
+    std::vector<atn::operation_totals> before = atn::merge_performance_counters();
+    std::thread worker([&]() { a *= b; });
+    worker.join();
+    std::vector<atn::operation_totals> after = atn::merge_performance_counters();
+    TEST("TEST_PERFORMANCE_COUNTERS", 1, after[MUL_TIME].calls - before[MUL_TIME].calls, uint64_t(1), false)
+    TEST("TEST_PERFORMANCE_COUNTERS", 2, after[MUL_TIME].sizes[KARATSUBA_TIER][bucket]
+        - before[MUL_TIME].sizes[KARATSUBA_TIER][bucket], uint64_t(1), false)
+    TEST("TEST_PERFORMANCE_COUNTERS", 3, atn::performance_test_json().find("\"MULTIPLICATION\"") != std::string::npos, true, false)
+    return result;
+}
+#endif
+
+#ifdef MEMORY_ACCOUNTING
+// Copying a value allocates exactly its words and the allocation is charged
+// to COPY, with the whole process totals growing by the same amount.
+bool test_memory_accounting(uint64_t n1, uint64_t n2) {
+    bool result = true;
+    atn::uInt a = (atn::uInt(n1 | 1) << 639) + n2;
+    uint64_t bytes = ((a.bits.size() + 63) >> 6) << 3;
+    std::vector<atn::operation_totals> before = atn::merge_performance_counters();
+    atn::memory_usage usage_before = atn::process_memory_usage();
+    atn::uInt copy(a);
+    std::vector<atn::operation_totals> after = atn::merge_performance_counters();
+    atn::memory_usage usage_after = atn::process_memory_usage();
+    TEST("TEST_MEMORY_ACCOUNTING", 1, after[COPY_TIME].allocations - before[COPY_TIME].allocations, uint64_t(1), false)
+    TEST("TEST_MEMORY_ACCOUNTING", 2, after[COPY_TIME].allocated_bytes - before[COPY_TIME].allocated_bytes, bytes, false)
+    TEST("TEST_MEMORY_ACCOUNTING", 3, usage_after.allocated_bytes - usage_before.allocated_bytes, bytes, false)
+    TEST("TEST_MEMORY_ACCOUNTING", 4, after[COPY_TIME].peak_bytes >= bytes, true, false)
+    return result;
+}
+#endif
+
 bool test_all(uint64_t n1, uint64_t n2) {
     bool result = true;
     result &= test_int_init(n1);
@@ -287,6 +911,7 @@ bool test_all(uint64_t n1, uint64_t n2) {
     result &= test_shift_left(n2);
     result &= test_shift_right(n1);
     result &= test_shift_right(n2);
+    result &= test_shift_words(n1, n2);
     result &= test_and(n1, n2);
     result &= test_or(n1, n2);
     result &= test_xor(n1, n2);
@@ -298,6 +923,35 @@ bool test_all(uint64_t n1, uint64_t n2) {
     result &= test_gte(n1, n2);
     result &= test_to_string(n1);
     result &= test_to_string(n2);
+    result &= test_product(n1, n2);
+    result &= test_factorial(n1);
+    result &= test_factorial(n2);
+    result &= test_binomial(n1, n2);
+    result &= test_fibonacci(n1);
+    result &= test_lucas(n2);
+    result &= test_linear_recurrence(n1, n2);
+    result &= test_fixed_uInt(n1, n2);
+    result &= test_import_export(n1, n2);
+    result &= test_mapped_uInt(n1, n2);
+    result &= test_uInt_view(n1, n2);
+    result &= test_shared_uInt(n1, n2);
+    result &= test_accumulator(n1, n2);
+    result &= test_rns_uInt(n1, n2);
+    result &= test_streams(n1, n2);
+    result &= test_base_conversion(n1, n2);
+    result &= test_bit_queries(n1, n2);
+    result &= test_literals(n1);
+    result &= test_word_arithmetic(n1, n2);
+    result &= test_gcd(n1, n2);
+    result &= test_roots(n1, n2);
+    result &= test_pow(n1, n2);
+    result &= test_primality(n1, n2);
+    #ifdef PERFORMANCE_TEST
+        result &= test_performance_counters(n1, n2);
+    #endif
+    #ifdef MEMORY_ACCOUNTING
+        result &= test_memory_accounting(n1, n2);
+    #endif
     if (!result) {
         std::cout << "Some test cases failed" << std::endl;
     } else {